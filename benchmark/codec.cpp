@@ -0,0 +1,175 @@
+#include "cigi/byte_swap.hpp"
+#include "cigi/columns.hpp"
+#include "cigi/session.hpp"
+#include "cigi/packet_view.hpp"
+#include "cigi/reflection.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// times the table-driven codecs (field reads, validation, byte swapping)
+// against the plain memcpy path, per packet. build with -DBUILD_BENCHMARKS=ON
+// in release mode.
+
+namespace
+{
+    constexpr std::size_t iterations = 100'000;
+
+    template <typename T>
+    auto keep(const T& value) -> void
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+    #else
+        static volatile T sink;
+        sink = value;
+    #endif
+    };
+
+    template <typename F>
+    auto time(std::string_view name, F&& f, std::size_t iterations = iterations) -> void
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            f();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        std::cout << "  " << std::left << std::setw(28) << name << std::fixed << std::setprecision(2) << ns << " ns\n";
+    };
+
+    template <cigi::cigi_packet T>
+    auto read_all_fields(std::span<const std::byte> bytes, std::endian order) -> void
+    {
+        [&]<std::size_t... I>(std::index_sequence<I...>)
+        {
+            (keep(cigi::read_field<T, I>(bytes, order)), ...);
+        }(std::make_index_sequence<T::fields.size()>{});
+    };
+
+    template <cigi::cigi_packet T>
+    auto run(std::string_view name, const T& packet) -> void
+    {
+        std::cout << name << " (" << sizeof(T) << " bytes)\n";
+
+        alignas(8) std::array<std::byte, sizeof(T)> bytes{};
+        T::serialize_into(packet, bytes);
+
+        time("serialize", [&]
+        {
+            auto result = T::serialize(packet);
+            keep(result.first.data.data());
+        });
+        time("serialize_into (memcpy)", [&]
+        {
+            keep(T::serialize_into(packet, bytes));
+        });
+        time("serialize_into (swapped)", [&]
+        {
+            keep(cigi::serialize_into(packet, bytes, std::endian::big == std::endian::native ? std::endian::little : std::endian::big));
+        });
+        cigi::serialized_data data = T::serialize(packet).first;
+        time("deserialize (memcpy)", [&]
+        {
+            T out;
+            keep(T::deserialize(data, out));
+            keep(out);
+        });
+        time("read every field (table)", [&]
+        {
+            read_all_fields<T>(bytes, std::endian::native);
+        });
+        time("validate_fields (table)", [&]
+        {
+            keep(cigi::validate_fields<T>(bytes));
+        });
+        time("byte_swap_packet (table)", [&]
+        {
+            keep(cigi::byte_swap_packet(bytes));
+        });
+    };
+
+    // many entity controls at once, as an IG sees them each frame.
+    auto run_columns() -> void
+    {
+        constexpr std::size_t count = 1024;
+        std::cout << "entity_control x " << count << ", 5 fields\n";
+
+        std::vector<std::byte> bytes(count * sizeof(cigi::entity_control));
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            cigi::entity_control ec;
+            ec.entity_id = cigi::u16(i);
+            cigi::entity_control::serialize_into(ec, std::span{ bytes }.subspan(i * sizeof(ec)));
+        }
+
+        // what receiving then read_all amounts to: a 48-byte struct per packet.
+        std::vector<cigi::entity_control> packets;
+        packets.reserve(count);
+        time("split and copy (AoS)", [&]
+        {
+            packets.clear();
+            for (std::size_t offset = 0; offset + 2 <= bytes.size(); offset += cigi::u8(bytes[offset + 1]))
+            {
+                if (cigi::u8(bytes[offset]) == decltype(cigi::entity_control::packet_id)::value)
+                {
+                    std::memcpy((void*)&packets.emplace_back(), bytes.data() + offset, sizeof(cigi::entity_control));
+                }
+            }
+            keep(packets.data());
+        });
+
+        std::vector<cigi::u16> ids(count);
+        std::vector<cigi::u8> states(count);
+        std::vector<cigi::f64> latitudes(count), longitudes(count);
+        std::vector<cigi::f32> yaws(count);
+        time("decode_columns (SoA)", [&]
+        {
+            keep(cigi::decode_columns<cigi::entity_control, "entity_id", "entity_state", "latitude", "longitude", "yaw">(bytes, ids, states, latitudes, longitudes, yaws));
+        });
+    };
+
+    // a burst of responses, received then drained.
+    auto run_queues() -> void
+    {
+        constexpr std::size_t count = 5000;
+        std::cout << "hat_hot_response x " << count << "\n";
+
+        std::array<std::byte, sizeof(cigi::hat_hot_response)> bytes{};
+        cigi::hat_hot_response::serialize_into(cigi::hat_hot_response{}, bytes);
+
+        cigi::session_network session;
+        time("queue and read_all", [&]
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                session.incoming.push(bytes);
+            }
+            keep(session.read_all<cigi::hat_hot_response>().size());
+        }, 1000);
+    };
+};
+
+auto main() -> int
+{
+    cigi::entity_control ec;
+    ec.entity_id = 17;
+    ec.latitude = 45.0;
+    ec.longitude = -120.0;
+    ec.altitude = 1000.0;
+    run("entity_control", ec);
+
+    cigi::ig_control igc;
+    run("ig_control", igc);
+
+    cigi::view_definition vd;
+    run("view_definition", vd);
+
+    run_columns();
+    run_queues();
+}
@@ -0,0 +1,111 @@
+#include "cigi/session.hpp"
+#include "cigi/loopback.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+// times whole frames through two sessions joined by a loopback_link, so the
+// serialization, dispatch and queueing are measured without the kernel.
+// build with -DBUILD_BENCHMARKS=ON in release mode.
+
+namespace
+{
+    constexpr std::size_t frames = 100'000;
+
+    auto report(std::string_view name, std::chrono::steady_clock::duration elapsed, std::size_t count, std::string_view unit) -> void
+    {
+        auto ns = std::chrono::duration<double, std::nano>(elapsed).count() / count;
+        std::cout << "  " << std::left << std::setw(28) << name << std::fixed << std::setprecision(2) << ns << " ns " << unit << "\n";
+    };
+
+    auto write_frame(cigi::session_network& host, std::size_t entities, std::uint32_t frame) -> void
+    {
+        cigi::ig_control control;
+        control.host_frame_number = frame;
+        host.write(control);
+        for (std::size_t i = 0; i < entities; ++i)
+        {
+            cigi::entity_control entity;
+            entity.entity_id = cigi::u16(i);
+            entity.latitude = 45.0 + double(frame) * 1e-6;
+            host.write(entity);
+        }
+        host.flush();
+    };
+
+    // host and IG on one thread: a frame written, flushed and read back.
+    auto run_throughput(std::size_t entities) -> void
+    {
+        cigi::loopback_link link;
+        cigi::session_network host;
+        cigi::session_network ig;
+        host.connect(link.host());
+        ig.connect(link.ig());
+
+        std::size_t received = 0;
+        ig.on<cigi::entity_control>([&](cigi::packet_view<cigi::entity_control>) { ++received; });
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t frame = 0; frame < frames; ++frame)
+        {
+            write_frame(host, entities, std::uint32_t(frame));
+            ig.drain();
+            ig.incoming.clear();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "ig_control + entity_control x " << entities << " (" << received / frames << " received per frame)\n";
+        report("frame", elapsed, frames, "per frame");
+        report("packet", elapsed, frames * (entities + 1), "per packet");
+    };
+
+    // the IG on its own thread answers each ig_control with a start_of_frame.
+    auto run_round_trip() -> void
+    {
+        using namespace std::chrono_literals;
+
+        cigi::loopback_link link;
+        cigi::session_network host;
+        cigi::session_network ig;
+        host.connect(link.host());
+        ig.connect(link.ig());
+
+        ig.on<cigi::ig_control>([&](cigi::packet_view<cigi::ig_control>)
+        {
+            ig.write(cigi::start_of_frame{});
+            ig.flush();
+        });
+        std::jthread responder{ [&](std::stop_token stop)
+        {
+            while (!stop.stop_requested())
+            {
+                ig.poll(1'000us);
+            }
+        } };
+
+        constexpr std::size_t round_trips = frames / 10;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t frame = 0; frame < round_trips; ++frame)
+        {
+            write_frame(host, 0, std::uint32_t(frame));
+            while (!host.poll(1'000us))
+            {
+            }
+            host.incoming.clear();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "ig_control -> start_of_frame, IG on another thread\n";
+        report("round trip", elapsed, round_trips, "");
+    };
+};
+
+auto main() -> int
+{
+    run_throughput(1);
+    run_throughput(32);
+    run_round_trip();
+}
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "general.hpp"
+#include "packet_view.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include <expected>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace cigi
+{
+    // why an awaited packet didn't arrive.
+    enum class wait_error : u8
+    {
+        // the deadline passed first.
+        timed_out = 0,
+        // the session was destroyed while waiting.
+        cancelled = 1,
+        // a matching packet arrived but failed to deserialize.
+        malformed = 2,
+    };
+
+    using wait_clock = std::chrono::steady_clock;
+
+    // one suspended coroutine waiting for a packet. lives in the coroutine's
+    // frame, so registering it allocates nothing beyond the deadline entry.
+    struct waiter
+    {
+        u8 packet_id = 0;
+        // matched on the u16 at byte 2 (hat_hot_id, los_id, object_id, ...)
+        // instead of calling matches.
+        bool keyed = false;
+        u16 key = 0;
+        wait_clock::time_point deadline = wait_clock::time_point::max();
+        std::coroutine_handle<> handle = {};
+
+        virtual auto matches(std::span<const std::byte> packet) const -> bool = 0;
+        virtual auto deliver(std::span<const std::byte> packet) -> void = 0;
+        virtual auto fail(wait_error error) -> void = 0;
+
+    protected:
+        ~waiter() = default;
+
+    private:
+        friend struct waiter_registry;
+
+        waiter* previous = nullptr;
+        waiter* next = nullptr;
+        std::multimap<wait_clock::time_point, waiter*>::iterator deadline_entry = {};
+    };
+
+    // the waiters of one session. packets are offered as they're received,
+    // and go to the oldest matching waiter; a waiter is resumed only after
+    // the whole datagram is dispatched, so it may freely await again.
+    struct waiter_registry
+    {
+        waiter_registry() = default;
+        waiter_registry(const waiter_registry&) = delete;
+        auto operator =(const waiter_registry&) -> waiter_registry& = delete;
+
+        auto add(waiter& w) -> void
+        {
+            append(list_of(w), w);
+            ++pending[w.packet_id];
+            keyed_pending[w.packet_id] += w.keyed;
+            w.deadline_entry = deadlines.emplace(w.deadline, &w);
+        };
+        auto remove(waiter& w) -> void
+        {
+            auto& list = list_of(w);
+            unlink(list, w);
+            if (w.keyed && list.head == nullptr)
+            {
+                keyed.erase(key_of(w.packet_id, w.key));
+            }
+            --pending[w.packet_id];
+            keyed_pending[w.packet_id] -= w.keyed;
+            deadlines.erase(w.deadline_entry);
+        };
+
+        // true if a waiter took the packet.
+        auto offer(std::span<const std::byte> packet) -> bool
+        {
+            u8 id = u8(packet[0]);
+            if (pending[id] == 0)
+            {
+                return false;
+            }
+
+            waiter* found = nullptr;
+            if (keyed_pending[id] != 0 && packet.size() >= 4)
+            {
+                u16 key;
+                std::memcpy(&key, packet.data() + 2, sizeof(key));
+                if (auto it = keyed.find(key_of(id, key)); it != keyed.end())
+                {
+                    found = it->second.head;
+                }
+            }
+            for (waiter* w = unkeyed[id].head; found == nullptr && w != nullptr; w = w->next)
+            {
+                if (w->matches(packet))
+                {
+                    found = w;
+                }
+            }
+            if (found == nullptr)
+            {
+                return false;
+            }
+
+            remove(*found);
+            found->deliver(packet);
+            ready.push_back(found->handle);
+            return true;
+        };
+        // fails every waiter whose deadline is at or before now.
+        auto expire(wait_clock::time_point now) -> void
+        {
+            while (!deadlines.empty() && deadlines.begin()->first <= now)
+            {
+                finish(*deadlines.begin()->second, wait_error::timed_out);
+            }
+        };
+        auto cancel_all() -> void
+        {
+            while (!deadlines.empty())
+            {
+                finish(*deadlines.begin()->second, wait_error::cancelled);
+            }
+            resume_ready();
+        };
+        // resumes the waiters given a packet or an error since the last call.
+        auto resume_ready() -> void
+        {
+            // resumed coroutines may await again, adding to ready.
+            while (!ready.empty())
+            {
+                resuming.swap(ready);
+                for (auto handle : resuming)
+                {
+                    handle.resume();
+                }
+                resuming.clear();
+            }
+        };
+
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return deadlines.size();
+        };
+        [[nodiscard]]
+        auto empty() const noexcept -> bool
+        {
+            return deadlines.empty();
+        };
+        // the earliest deadline, for sizing an event loop's poll timeout.
+        [[nodiscard]]
+        auto next_deadline() const noexcept -> wait_clock::time_point
+        {
+            return deadlines.empty() ? wait_clock::time_point::max() : deadlines.begin()->first;
+        };
+
+    private:
+        struct list
+        {
+            waiter* head = nullptr;
+            waiter* tail = nullptr;
+        };
+
+        static auto key_of(u8 packet_id, u16 key) noexcept -> u32
+        {
+            return (u32(packet_id) << 16) | key;
+        };
+        auto list_of(waiter& w) -> list&
+        {
+            return w.keyed ? keyed[key_of(w.packet_id, w.key)] : unkeyed[w.packet_id];
+        };
+        static auto append(list& l, waiter& w) noexcept -> void
+        {
+            w.previous = l.tail;
+            w.next = nullptr;
+            (l.tail ? l.tail->next : l.head) = &w;
+            l.tail = &w;
+        };
+        static auto unlink(list& l, waiter& w) noexcept -> void
+        {
+            (w.previous ? w.previous->next : l.head) = w.next;
+            (w.next ? w.next->previous : l.tail) = w.previous;
+            w.previous = nullptr;
+            w.next = nullptr;
+        };
+        auto finish(waiter& w, wait_error error) -> void
+        {
+            remove(w);
+            w.fail(error);
+            ready.push_back(w.handle);
+        };
+
+        std::array<list, 256> unkeyed = {};
+        std::unordered_map<u32, list> keyed = {};
+        std::array<u32, 256> pending = {};
+        std::array<u32, 256> keyed_pending = {};
+        std::multimap<wait_clock::time_point, waiter*> deadlines = {};
+        std::vector<std::coroutine_handle<>> ready = {};
+        std::vector<std::coroutine_handle<>> resuming = {};
+    };
+
+    // matches any packet of the awaited type.
+    struct any_packet
+    {
+        template <typename T>
+        constexpr auto operator ()(const T&) const noexcept -> bool
+        {
+            return true;
+        };
+    };
+
+    // co_await'ing this suspends until the next matching T is received, or
+    // the deadline passes. packets already queued before the await aren't
+    // considered; read<T> those.
+    template <cigi_packet T, typename Match = any_packet>
+    struct packet_awaiter final : waiter
+    {
+        packet_awaiter(waiter_registry& registry, Match match, wait_clock::time_point deadline) :
+            registry{ &registry },
+            match{ std::move(match) }
+        {
+            packet_id = decltype(T::packet_id)::value;
+            this->deadline = deadline;
+        };
+        packet_awaiter(waiter_registry& registry, u16 key, wait_clock::time_point deadline) :
+            packet_awaiter{ registry, Match{}, deadline }
+        {
+            keyed = true;
+            this->key = key;
+        };
+        packet_awaiter(const packet_awaiter&) = delete;
+
+        auto await_ready() const noexcept -> bool
+        {
+            return false;
+        };
+        auto await_suspend(std::coroutine_handle<> h) -> void
+        {
+            handle = h;
+            registry->add(*this);
+        };
+        auto await_resume() -> std::expected<T, wait_error>
+        {
+            return std::move(result);
+        };
+
+        auto matches(std::span<const std::byte> packet) const -> bool override
+        {
+            packet_view<T> view{ packet };
+            return view.valid() && match(view);
+        };
+        auto deliver(std::span<const std::byte> packet) -> void override
+        {
+            serialized_data data{ packet.data(), packet.size() };
+            T out;
+            if (T::deserialize(data, out) == serialized_data::errors::none)
+            {
+                result = std::move(out);
+            }
+            else
+            {
+                result = std::unexpected{ wait_error::malformed };
+            }
+        };
+        auto fail(wait_error error) -> void override
+        {
+            result = std::unexpected{ error };
+        };
+
+    private:
+        waiter_registry* registry;
+        [[no_unique_address]] Match match;
+        std::expected<T, wait_error> result = std::unexpected{ wait_error::cancelled };
+    };
+
+    // whether a packet carries a request id in the u16 at byte 2, the way
+    // the responses do, so awaiting one by id is a hash lookup.
+    template <cigi_packet T>
+    consteval auto has_request_id() -> bool
+    {
+        return T::fields.size() > 2 && T::fields[2].offset == 2 && T::fields[2].size == 2 && T::fields[2].bit_width == 0;
+    };
+
+    // a coroutine that starts immediately and frees its own frame when it
+    // finishes, for running awaits on an event-loop thread:
+    //
+    //     auto query = [&](u16 id) -> cigi::detached_task
+    //     {
+    //         auto response = co_await session.next<hat_hot_response>(id, deadline);
+    //         ...
+    //     };
+    //
+    // exceptions escaping it terminate.
+    struct detached_task
+    {
+        struct promise_type
+        {
+            auto get_return_object() noexcept -> detached_task
+            {
+                return {};
+            };
+            auto initial_suspend() noexcept -> std::suspend_never
+            {
+                return {};
+            };
+            auto final_suspend() noexcept -> std::suspend_never
+            {
+                return {};
+            };
+            auto return_void() noexcept -> void {};
+            auto unhandled_exception() noexcept -> void
+            {
+                std::terminate();
+            };
+        };
+    };
+};
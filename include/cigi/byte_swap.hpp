@@ -0,0 +1,223 @@
+#pragma once
+
+#include "packets.hpp"
+#include "reflection.hpp"
+
+#include <bit>
+#include <optional>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#   include <immintrin.h>
+#endif
+
+namespace cigi
+{
+    // packets from a peer of the opposite byte order are swapped 16 bytes at a
+    // time, each chunk permuted by a precomputed shuffle that reverses every
+    // field inside it. the shuffles come from each packet's fields (and
+    // element_fields, for the repeating tail of variable-length packets).
+    // fields are naturally aligned, so no field straddles two chunks. without
+    // SSSE3 the field tables are unrolled into plain scalar swaps instead.
+    struct swap_plan
+    {
+        static constexpr std::size_t chunk_size = 16;
+        static constexpr std::size_t max_chunks = 256 / chunk_size;
+
+        alignas(32) std::array<std::array<u8, chunk_size>, max_chunks> masks{};
+    };
+
+    template <cigi_packet T>
+    consteval auto make_swap_plan() -> swap_plan
+    {
+        swap_plan plan;
+        for (std::size_t chunk = 0; chunk < swap_plan::max_chunks; ++chunk)
+        {
+            for (std::size_t i = 0; i < swap_plan::chunk_size; ++i)
+            {
+                plan.masks[chunk][i] = u8(i);
+            }
+        }
+
+        auto reverse = [&](std::size_t offset, std::size_t width)
+        {
+            for (std::size_t i = 0; i < width; ++i)
+            {
+                std::size_t byte = offset + i;
+                plan.masks[byte / swap_plan::chunk_size][byte % swap_plan::chunk_size] = u8((offset + width - 1 - i) % swap_plan::chunk_size);
+            }
+        };
+        auto reverse_fields = [&](const auto& fields, std::size_t base)
+        {
+            for (const auto& field : fields)
+            {
+                if (!field.alias && field.bit_width == 0 && field.size > 1)
+                {
+                    reverse(base + field.offset, field.size);
+                }
+            }
+        };
+
+        constexpr std::size_t fixed_size = detail::fixed_size<T>();
+        reverse_fields(T::fields, 0);
+        if constexpr (requires { T::element_fields; })
+        {
+            constexpr std::size_t element_size = detail::element_size<T>();
+            for (std::size_t offset = fixed_size; offset + element_size <= swap_plan::max_chunks * swap_plan::chunk_size; offset += element_size)
+            {
+                reverse_fields(T::element_fields, offset);
+            }
+        }
+
+        return plan;
+    };
+
+    struct swap_table
+    {
+        // packet id to index into plans. 0 is reserved for ids we don't know
+        // the layout of (e.g. user-defined packets), which are left untouched.
+        std::array<u8, 256> index{};
+        std::array<swap_plan, all_packets::size + 1> plans{};
+        // the same swaps as unrolled scalar code, for targets without a byte
+        // shuffle instruction.
+        std::array<void (*)(std::span<std::byte>) noexcept, all_packets::size + 1> swappers{};
+    };
+
+    consteval auto make_swap_table() -> swap_table
+    {
+        swap_table table;
+        std::size_t next = 1;
+        all_packets::for_each([&]<cigi_packet T>()
+        {
+            table.index[decltype(T::packet_id)::value] = u8(next);
+            table.plans[next] = make_swap_plan<T>();
+            table.swappers[next] = &byte_swap_fields<T>;
+            ++next;
+        });
+        return table;
+    };
+
+    inline constexpr swap_table swap_plans = make_swap_table();
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+    inline auto swap_chunk(std::byte* chunk, const std::array<u8, swap_plan::chunk_size>& mask) noexcept -> void
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)chunk);
+        __m128i shuffle = _mm_load_si128((const __m128i*)mask.data());
+        _mm_storeu_si128((__m128i*)chunk, _mm_shuffle_epi8(bytes, shuffle));
+    };
+#endif
+
+    // swaps every field of one packet in place. returns false, leaving the
+    // packet as-is, if its id has no known layout.
+    inline auto byte_swap_packet(std::span<std::byte> packet) noexcept -> bool
+    {
+        if (packet.empty())
+        {
+            return false;
+        }
+
+        u8 index = swap_plans.index[u8(packet[0])];
+        if (index == 0)
+        {
+            return false;
+        }
+
+    #if defined(__AVX2__) || defined(__SSSE3__)
+        const auto& masks = swap_plans.plans[index].masks;
+        std::size_t size = std::min(packet.size(), swap_plan::max_chunks * swap_plan::chunk_size);
+        std::size_t chunk = 0;
+    #if defined(__AVX2__)
+        // the masks are adjacent in memory, so two chunks go through one
+        // 256-bit shuffle (which shuffles each 128-bit lane independently).
+        for (; (chunk + 2) * swap_plan::chunk_size <= size; chunk += 2)
+        {
+            auto start = packet.data() + chunk * swap_plan::chunk_size;
+            __m256i bytes = _mm256_loadu_si256((const __m256i*)start);
+            __m256i shuffle = _mm256_load_si256((const __m256i*)masks[chunk].data());
+            _mm256_storeu_si256((__m256i*)start, _mm256_shuffle_epi8(bytes, shuffle));
+        }
+    #endif
+        for (; (chunk + 1) * swap_plan::chunk_size <= size; ++chunk)
+        {
+            swap_chunk(packet.data() + chunk * swap_plan::chunk_size, masks[chunk]);
+        }
+
+        // packets are multiples of 8 bytes, so there can be a half chunk left.
+        if (std::size_t start = chunk * swap_plan::chunk_size; start < size)
+        {
+            std::array<std::byte, swap_plan::chunk_size> tail{};
+            std::memcpy(tail.data(), packet.data() + start, size - start);
+            swap_chunk(tail.data(), masks[chunk]);
+            std::memcpy(packet.data() + start, tail.data(), size - start);
+        }
+
+    #else
+        swap_plans.swappers[index](packet.first(std::min(packet.size(), swap_plan::max_chunks * swap_plan::chunk_size)));
+    #endif
+
+        return true;
+    };
+
+    // swaps every packet of a datagram in place, in one pass. stops at the
+    // first packet whose size doesn't fit in what remains.
+    inline auto byte_swap_datagram(std::span<std::byte> datagram) noexcept -> void
+    {
+        std::size_t offset = 0;
+        while (offset + 2 <= datagram.size())
+        {
+            std::size_t size = u8(datagram[offset + 1]);
+            if (size < 2 || offset + size > datagram.size())
+            {
+                break;
+            }
+
+            byte_swap_packet(datagram.subspan(offset, size));
+            offset += size;
+        }
+    };
+
+    // serializes a packet in the given byte order, e.g. to answer a peer of
+    // the opposite byte order in its own.
+    template <cigi_packet T>
+    auto serialize_into(const T& packet, std::span<std::byte> buffer, std::endian order) -> serialize_into_result
+    {
+        auto result = T::serialize_into(packet, buffer);
+        if (result.second == serialized_data::errors::none && order != std::endian::native)
+        {
+            byte_swap_packet(buffer.first(result.first));
+        }
+        return result;
+    };
+
+    // the byte order a datagram was written in, from the byte swap magic number
+    // of the IG Control or Start of Frame that begins it. nullopt if it begins
+    // with neither, or the magic number is damaged.
+    inline auto detect_byte_order(std::span<const std::byte> datagram) noexcept -> std::optional<std::endian>
+    {
+        // both packets keep the magic number at the same offset.
+        constexpr std::size_t magic_offset = 6;
+        if (datagram.size() < magic_offset + sizeof(u16))
+        {
+            return std::nullopt;
+        }
+
+        u8 id = u8(datagram[0]);
+        if (id != decltype(ig_control::packet_id)::value && id != decltype(start_of_frame::packet_id)::value)
+        {
+            return std::nullopt;
+        }
+
+        u16 magic;
+        std::memcpy(&magic, datagram.data() + magic_offset, sizeof(u16));
+        if (magic == 0x8000)
+        {
+            return std::endian::native;
+        }
+        else if (magic == 0x0080)
+        {
+            return std::endian::native == std::endian::little ? std::endian::big : std::endian::little;
+        }
+
+        return std::nullopt;
+    };
+};
\ No newline at end of file
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "general.hpp"
+#include "reflection.hpp"
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#endif
+
+namespace cigi
+{
+    // bulk decoding of one packet type into columns (structure of arrays),
+    // e.g. every entity_control's entity_id, latitude and yaw in a datagram
+    // into three contiguous arrays:
+    //
+    //     std::array<u16, 256> ids;
+    //     std::array<f64, 256> latitudes;
+    //     std::array<f32, 256> yaws;
+    //     auto rows = decode_columns<entity_control, "entity_id", "latitude", "yaw">(datagram, ids, latitudes, yaws);
+    //
+    // each column has the wire type of its field (bitfields are a u8). packets
+    // are read in native byte order, as session_network leaves them.
+    template <cigi_packet T, field_name name>
+    using column_t = wire_cpp_t<T::fields[field_index<T>(name.view())].type>;
+
+    namespace detail
+    {
+        // how many offsets are gathered per batch, bounding stack use.
+        inline constexpr std::size_t column_batch = 64;
+
+        // fills out with field I of the packets at base + offsets, one row per
+        // offset. offsets are byte distances from base, which need not be one
+        // buffer.
+        template <cigi_packet T, std::size_t I>
+        auto gather_column(const std::byte* base, std::span<const s64> offsets, wire_cpp_t<T::fields[I].type>* out) noexcept -> void
+        {
+            std::size_t count = offsets.size();
+            auto at = [base](s64 offset)
+            {
+                return (const std::byte*)(std::uintptr_t(base) + std::uintptr_t(offset));
+            };
+
+            std::size_t i = 0;
+        #if defined(__AVX2__)
+            constexpr field_descriptor field = T::fields[I];
+            using type = wire_cpp_t<field.type>;
+            const std::size_t vectorized = count & ~std::size_t(3);
+            const std::byte* source = at(field.offset);
+            if constexpr (sizeof(type) == 8)
+            {
+                for (; i < vectorized; i += 4)
+                {
+                    __m256i index = _mm256_loadu_si256((const __m256i*)(offsets.data() + i));
+                    __m256i values = _mm256_i64gather_epi64((const long long*)source, index, 1);
+                    _mm256_storeu_si256((__m256i*)(out + i), values);
+                }
+            }
+            else if constexpr (sizeof(type) == 4)
+            {
+                for (; i < vectorized; i += 4)
+                {
+                    __m256i index = _mm256_loadu_si256((const __m256i*)(offsets.data() + i));
+                    __m128i values = _mm256_i64gather_epi32((const int*)source, index, 1);
+                    _mm_storeu_si128((__m128i*)(out + i), values);
+                }
+            }
+            else if constexpr (field.offset + 4 <= detail::fixed_size<T>())
+            {
+                // narrower fields are gathered as the 4 bytes starting at them,
+                // which stay inside the packet, then shifted, masked and packed.
+                constexpr u32 mask = field.bit_width != 0 ? (1u << field.bit_width) - 1 : (1u << (8 * sizeof(type))) - 1;
+                const __m128i pack = sizeof(type) == 2
+                    ? _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1)
+                    : _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+                for (; i < vectorized; i += 4)
+                {
+                    __m256i index = _mm256_loadu_si256((const __m256i*)(offsets.data() + i));
+                    __m128i values = _mm256_i64gather_epi32((const int*)source, index, 1);
+                    values = _mm_and_si128(_mm_srli_epi32(values, field.bit_offset), _mm_set1_epi32(int(mask)));
+                    values = _mm_shuffle_epi8(values, pack);
+                    if constexpr (sizeof(type) == 2)
+                    {
+                        _mm_storel_epi64((__m128i*)(out + i), values);
+                    }
+                    else
+                    {
+                        u32 packed = u32(_mm_cvtsi128_si32(values));
+                        std::memcpy(out + i, &packed, sizeof(packed));
+                    }
+                }
+            }
+        #endif
+            for (; i < count; ++i)
+            {
+                out[i] = read_field<T, I>(std::span{ at(offsets[i]), detail::fixed_size<T>() });
+            }
+        };
+
+        template <cigi_packet T, field_name... names>
+        auto gather_columns(const std::byte* base, std::span<const s64> offsets, std::size_t row, std::span<column_t<T, names>>... columns) noexcept -> void
+        {
+            (gather_column<T, field_index<T>(names.view())>(base, offsets, columns.data() + row), ...);
+        };
+    };
+
+    // decodes the named fields of every T in a datagram into the columns, up
+    // to the shortest column's length. returns the number of rows written.
+    template <cigi_packet T, field_name... names>
+    requires (sizeof...(names) > 0)
+    auto decode_columns(std::span<const std::byte> datagram, std::span<column_t<T, names>>... columns) noexcept -> std::size_t
+    {
+        std::size_t capacity = std::min({ columns.size()... });
+        std::array<s64, detail::column_batch> offsets;
+        std::size_t batched = 0;
+        std::size_t rows = 0;
+
+        std::size_t offset = 0;
+        while (offset + 2 <= datagram.size() && rows + batched < capacity)
+        {
+            std::size_t size = u8(datagram[offset + 1]);
+            if (size < 2 || offset + size > datagram.size())
+            {
+                break;
+            }
+
+            if (u8(datagram[offset]) == decltype(T::packet_id)::value && size >= detail::fixed_size<T>())
+            {
+                offsets[batched++] = s64(offset);
+                if (batched == offsets.size())
+                {
+                    detail::gather_columns<T, names...>(datagram.data(), std::span{ offsets }.first(batched), rows, columns...);
+                    rows += batched;
+                    batched = 0;
+                }
+            }
+            offset += size;
+        }
+
+        detail::gather_columns<T, names...>(datagram.data(), std::span{ offsets }.first(batched), rows, columns...);
+        return rows + batched;
+    };
+
+    // the same, for packets that are already separated, e.g. queued ones.
+    template <cigi_packet T, field_name... names>
+    requires (sizeof...(names) > 0)
+    auto decode_columns(std::span<const std::byte* const> packets, std::span<column_t<T, names>>... columns) noexcept -> std::size_t
+    {
+        std::size_t count = std::min({ packets.size(), columns.size()... });
+        std::array<s64, detail::column_batch> offsets;
+        for (std::size_t row = 0; row < count; row += offsets.size())
+        {
+            std::size_t batched = std::min(offsets.size(), count - row);
+            const std::byte* base = packets[row];
+            for (std::size_t i = 0; i < batched; ++i)
+            {
+                offsets[i] = s64(std::uintptr_t(packets[row + i]) - std::uintptr_t(base));
+            }
+            detail::gather_columns<T, names...>(base, std::span{ offsets }.first(batched), row, columns...);
+        }
+        return count;
+    };
+};
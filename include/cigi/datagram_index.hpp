@@ -0,0 +1,178 @@
+#pragma once
+
+#include "general.hpp"
+#include "packets.hpp"
+#include "packet_view.hpp"
+
+#include <optional>
+#include <vector>
+
+namespace cigi
+{
+    // the sizes a packet id may have on the wire. fixed-size packets may be
+    // longer than we know of (a newer minor version), never shorter.
+    struct packet_size_range
+    {
+        u8 minimum = 2;
+        u8 maximum = 255;
+        bool known = false;
+    };
+
+    consteval auto make_packet_size_table() -> std::array<packet_size_range, 256>
+    {
+        std::array<packet_size_range, 256> table{};
+        all_packets::for_each([&]<cigi_packet T>()
+        {
+            auto& range = table[decltype(T::packet_id)::value];
+            range.known = true;
+            if constexpr (is_constant_v<decltype(T::packet_size)>)
+            {
+                range.minimum = u8(sizeof(T));
+            }
+            else
+            {
+                using size_type = decltype(T::packet_size);
+                range.minimum = size_type{ 0 }.value;
+                range.maximum = size_type{ 255 }.value;
+            }
+        });
+        return table;
+    };
+
+    // indexed by packet id. ids without a layout (e.g. user-defined packets)
+    // accept any size.
+    inline constexpr std::array<packet_size_range, 256> packet_sizes = make_packet_size_table();
+
+    // one pass over a received datagram, recording where each packet is after
+    // checking its size. the datagram must outlive the index.
+    struct datagram_index
+    {
+        struct entry
+        {
+            u8 packet_id = 0;
+            u8 size = 0;
+            u16 offset = 0;
+        };
+
+        datagram_index() = default;
+        explicit datagram_index(std::span<const std::byte> datagram)
+        {
+            index(datagram);
+        };
+
+        // replaces the current contents, keeping the entries' capacity.
+        // packets of the wrong size for their id are skipped and flagged, and
+        // the walk stops at a packet that would run past the datagram.
+        auto index(std::span<const std::byte> datagram) -> serialized_data::errors
+        {
+            bytes = datagram;
+            entries.clear();
+
+            int errors = 0;
+            std::size_t offset = 0;
+            while (offset < bytes.size())
+            {
+                if (offset + 2 > bytes.size())
+                {
+                    errors |= int(serialized_data::errors::truncated_packet);
+                    break;
+                }
+
+                u8 id = u8(bytes[offset]);
+                u8 size = u8(bytes[offset + 1]);
+                if (size < 2 || offset + size > bytes.size())
+                {
+                    errors |= int(serialized_data::errors::truncated_packet);
+                    break;
+                }
+
+                const auto& range = packet_sizes[id];
+                if (size < range.minimum)
+                {
+                    errors |= int(serialized_data::errors::truncated_packet);
+                }
+                else if (size > range.maximum)
+                {
+                    errors |= int(serialized_data::errors::mismatched_constant);
+                }
+                else
+                {
+                    entries.push_back({ id, size, u16(offset) });
+                }
+                offset += size;
+            }
+
+            status = serialized_data::errors(errors);
+            return status;
+        };
+
+        [[nodiscard]]
+        auto errors() const noexcept -> serialized_data::errors
+        {
+            return status;
+        };
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return entries.size();
+        };
+        [[nodiscard]]
+        auto empty() const noexcept -> bool
+        {
+            return entries.empty();
+        };
+        auto begin() const noexcept
+        {
+            return entries.begin();
+        };
+        auto end() const noexcept
+        {
+            return entries.end();
+        };
+        auto operator [](std::size_t i) const noexcept -> const entry&
+        {
+            return entries[i];
+        };
+
+        // the bytes of an indexed packet.
+        [[nodiscard]]
+        auto packet(const entry& e) const noexcept -> std::span<const std::byte>
+        {
+            return bytes.subspan(e.offset, e.size);
+        };
+        [[nodiscard]]
+        auto count(u8 packet_id) const noexcept -> std::size_t
+        {
+            return std::size_t(std::ranges::count(entries, packet_id, &entry::packet_id));
+        };
+
+        // a view of the i'th packet, if it's a T.
+        template <cigi_packet T>
+        [[nodiscard]]
+        auto view(std::size_t i) const noexcept -> std::optional<packet_view<T>>
+        {
+            if (i < entries.size() && entries[i].packet_id == decltype(T::packet_id)::value)
+            {
+                return packet_view<T>{ packet(entries[i]) };
+            }
+            return std::nullopt;
+        };
+        // calls f(packet_view<T>) for every T, in datagram order.
+        template <cigi_packet T, typename F>
+        auto for_each(F&& f) const -> void
+        {
+            for (const auto& e : entries)
+            {
+                if (e.packet_id == decltype(T::packet_id)::value)
+                {
+                    f(packet_view<T>{ packet(e) });
+                }
+            }
+        };
+
+    private:
+        std::span<const std::byte> bytes = {};
+        std::vector<entry> entries = {};
+        serialized_data::errors status = serialized_data::errors::none;
+    };
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "general.hpp"
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace cigi
+{
+    // lock-free single-producer/single-consumer ring of datagram buffers. the
+    // buffers are allocated once, up front; the producer fills one in place
+    // and commits it, the consumer reads it in place and pops it. a consumer
+    // with nothing to read may sleep in wait, which costs the producer a
+    // lock only while it's asleep.
+    struct datagram_ring
+    {
+        static constexpr std::size_t default_slots = 64;
+        static constexpr std::size_t default_slot_size = 2048;
+
+        // slots is rounded up to a power of two.
+        explicit datagram_ring(std::size_t slots = default_slots, std::size_t slot_size = default_slot_size) :
+            mask{ std::bit_ceil(std::max<std::size_t>(slots, 2)) - 1 },
+            slot_size{ slot_size },
+            buffers(slot_size * (mask + 1)),
+            sizes(mask + 1)
+        {};
+
+        // producer: the next free buffer, or empty when the ring is full, in
+        // which case the overrun is counted.
+        [[nodiscard]]
+        auto acquire() noexcept -> std::span<std::byte>
+        {
+            std::size_t head = write.load(std::memory_order_relaxed);
+            if (head - read_cache == mask + 1)
+            {
+                read_cache = read.load(std::memory_order_acquire);
+                if (head - read_cache == mask + 1)
+                {
+                    overrun_count.fetch_add(1, std::memory_order_relaxed);
+                    return {};
+                }
+            }
+            return { buffers.data() + (head & mask) * slot_size, slot_size };
+        };
+        // producer: publishes the buffer from acquire, holding size bytes.
+        auto commit(std::size_t size) noexcept -> void
+        {
+            std::size_t head = write.load(std::memory_order_relaxed);
+            sizes[head & mask] = std::min(size, slot_size);
+            write.store(head + 1, std::memory_order_seq_cst);
+            if (sleeping.load(std::memory_order_seq_cst))
+            {
+                std::lock_guard lock{ wake_mutex };
+                wake.notify_one();
+            }
+
+            std::size_t occupied = head + 1 - read.load(std::memory_order_relaxed);
+            if (occupied > high_water.load(std::memory_order_relaxed))
+            {
+                high_water.store(occupied, std::memory_order_relaxed);
+            }
+        };
+
+        // consumer: the oldest committed datagram, if any.
+        [[nodiscard]]
+        auto front() noexcept -> std::optional<std::span<std::byte>>
+        {
+            return peek(0);
+        };
+        // consumer: the committed datagram offset places after the oldest, if
+        // there is one, to read several before popping them.
+        [[nodiscard]]
+        auto peek(std::size_t offset) noexcept -> std::optional<std::span<std::byte>>
+        {
+            std::size_t tail = read.load(std::memory_order_relaxed);
+            if (offset >= write_cache - tail)
+            {
+                write_cache = write.load(std::memory_order_acquire);
+                if (offset >= write_cache - tail)
+                {
+                    return std::nullopt;
+                }
+            }
+            std::size_t slot = (tail + offset) & mask;
+            return std::span{ buffers.data() + slot * slot_size, sizes[slot] };
+        };
+        // consumer: waits up to timeout for more than offset datagrams to be
+        // committed, asleep rather than spinning. true if they are.
+        auto wait(std::chrono::microseconds timeout, std::size_t offset = 0) -> bool
+        {
+            if (peek(offset))
+            {
+                return true;
+            }
+
+            std::unique_lock lock{ wake_mutex };
+            sleeping.store(true, std::memory_order_seq_cst);
+            bool ready = wake.wait_for(lock, timeout, [&]
+            {
+                return write.load(std::memory_order_seq_cst) - read.load(std::memory_order_relaxed) > offset;
+            });
+            sleeping.store(false, std::memory_order_relaxed);
+            return ready;
+        };
+        // consumer: releases the oldest count datagrams back to the producer.
+        auto pop(std::size_t count = 1) noexcept -> void
+        {
+            read.store(read.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        };
+
+        [[nodiscard]]
+        auto capacity() const noexcept -> std::size_t
+        {
+            return mask + 1;
+        };
+        // bytes each buffer holds.
+        [[nodiscard]]
+        auto buffer_size() const noexcept -> std::size_t
+        {
+            return slot_size;
+        };
+        // datagrams waiting, as of the call. exact only on the consumer thread.
+        [[nodiscard]]
+        auto occupancy() const noexcept -> std::size_t
+        {
+            return write.load(std::memory_order_acquire) - read.load(std::memory_order_acquire);
+        };
+        [[nodiscard]]
+        auto high_water_mark() const noexcept -> std::size_t
+        {
+            return high_water.load(std::memory_order_relaxed);
+        };
+        // datagrams dropped because the ring was full.
+        [[nodiscard]]
+        auto overruns() const noexcept -> u64
+        {
+            return overrun_count.load(std::memory_order_relaxed);
+        };
+
+    private:
+        static constexpr std::size_t cache_line = 64;
+
+        const std::size_t mask;
+        const std::size_t slot_size;
+        std::vector<std::byte> buffers;
+        std::vector<std::size_t> sizes;
+
+        // each side's index, and its cached copy of the other's, on its own
+        // cache line so the threads don't false-share.
+        alignas(cache_line) std::atomic<std::size_t> write = 0;
+        std::size_t read_cache = 0;
+        alignas(cache_line) std::atomic<std::size_t> read = 0;
+        std::size_t write_cache = 0;
+        alignas(cache_line) std::atomic<std::size_t> high_water = 0;
+        std::atomic<u64> overrun_count = 0;
+        // set while the consumer sleeps in wait, for commit to wake it.
+        std::atomic<bool> sleeping = false;
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+    };
+};
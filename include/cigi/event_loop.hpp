@@ -0,0 +1,42 @@
+#pragma once
+
+#include "session.hpp"
+
+#include <chrono>
+#include <memory>
+#include <stop_token>
+
+namespace cigi
+{
+    // waits on the receive sockets of any number of sessions from one thread,
+    // e.g. one session per IG channel, and drains each as it becomes
+    // readable. uses edge-triggered epoll on linux and select elsewhere.
+    //
+    // added sessions' sockets are made non-blocking, and must be connected
+    // first and not use a receive thread. sessions are polled by the loop
+    // only; don't poll them from elsewhere at the same time.
+    struct event_loop
+    {
+        event_loop();
+        ~event_loop();
+
+        // false if the session's receive socket isn't connected or can't be
+        // waited on. a session that changes its socket backend afterwards
+        // is removed and added again, as the descriptor waited on changes.
+        auto add(session_network& session) -> bool;
+        auto remove(session_network& session) -> void;
+        [[nodiscard]]
+        auto size() const -> std::size_t;
+
+        // waits for up to timeout, or until the earliest await deadline of
+        // any session, then drains every ready session and times out expired
+        // awaits. returns the number of datagrams read.
+        auto run_once(std::chrono::microseconds timeout) -> std::size_t;
+        // runs until stop is requested.
+        auto run(std::stop_token stop) -> void;
+
+    private:
+        struct event_loop_impl;
+        std::unique_ptr<event_loop_impl> impl;
+    };
+};
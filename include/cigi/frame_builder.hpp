@@ -0,0 +1,202 @@
+#pragma once
+
+#include "packets.hpp"
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace cigi
+{
+    // how frame_builder fills datagrams after the leading packet.
+    enum class packing : u8
+    {
+        // in the order written, each datagram filled before the next is
+        // started: the fewest datagrams that keep that order.
+        in_order = 0,
+        // largest packets first, each into the first datagram with room,
+        // for the fewest datagrams overall. packets may arrive out of the
+        // order written, so only for frames where that doesn't matter.
+        first_fit_decreasing = 1,
+    };
+
+    // one datagram of a built frame: packets [first, first + count) of the
+    // ordered packets.
+    struct frame_datagram
+    {
+        std::size_t first = 0;
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+    };
+
+    // lays out a frame's packets for sending: the IG Control (or, from an IG,
+    // the Start of Frame) first in the first datagram, as the protocol
+    // requires, and the rest packed whole into datagrams of up to mtu bytes.
+    // a packet longer than the mtu goes alone.
+    //
+    // the order is such that splitting it at packet boundaries, filling each
+    // datagram before starting the next, gives exactly these datagrams, so
+    // the ordered packets can go straight to send_packets with the same mtu.
+    struct frame_builder
+    {
+        explicit frame_builder(cigi::packing packing = packing::in_order) :
+            mode{ packing }
+        {};
+
+        auto set_packing(cigi::packing packing) noexcept -> void
+        {
+            mode = packing;
+        };
+        [[nodiscard]]
+        auto packing() const noexcept -> cigi::packing
+        {
+            return mode;
+        };
+
+        // the packets reordered for sending, valid until the next build.
+        auto build(std::span<const std::span<const std::byte>> packets, std::size_t mtu) -> std::span<const std::span<const std::byte>>
+        {
+            last_mtu = std::max<std::size_t>(mtu, 1);
+            ordered.clear();
+            datagram_list.clear();
+            if (packets.empty())
+            {
+                return {};
+            }
+
+            auto leads = [](std::span<const std::byte> packet)
+            {
+                u8 id = packet.empty() ? 0 : u8(packet[0]);
+                return id == decltype(ig_control::packet_id)::value || id == decltype(start_of_frame::packet_id)::value;
+            };
+            std::size_t lead = std::size_t(std::ranges::find_if(packets, leads) - packets.begin());
+
+            if (mode == packing::in_order)
+            {
+                if (lead != packets.size())
+                {
+                    ordered.push_back(packets[lead]);
+                }
+                for (std::size_t i = 0; i < packets.size(); ++i)
+                {
+                    if (i != lead)
+                    {
+                        ordered.push_back(packets[i]);
+                    }
+                }
+                split();
+            }
+            else
+            {
+                pack(packets, lead);
+            }
+            return ordered;
+        };
+
+        // the datagrams of the last build, in sending order.
+        [[nodiscard]]
+        auto datagrams() const noexcept -> std::span<const frame_datagram>
+        {
+            return datagram_list;
+        };
+        // how full datagram i of the last build is, from 0 to 1 (or more, for
+        // a packet longer than the mtu).
+        [[nodiscard]]
+        auto fill(std::size_t i) const noexcept -> double
+        {
+            return double(datagram_list[i].bytes) / double(last_mtu);
+        };
+        // the bytes of the last build over the room in its datagrams.
+        [[nodiscard]]
+        auto mean_fill() const noexcept -> double
+        {
+            std::size_t bytes = 0;
+            for (const auto& datagram : datagram_list)
+            {
+                bytes += datagram.bytes;
+            }
+            return datagram_list.empty() ? 0.0 : double(bytes) / double(last_mtu * datagram_list.size());
+        };
+
+    private:
+        // the datagrams of ordered, each filled before the next is started.
+        auto split() -> void
+        {
+            for (std::size_t i = 0; i < ordered.size(); ++i)
+            {
+                std::size_t size = ordered[i].size();
+                if (datagram_list.empty() || datagram_list.back().bytes + size > last_mtu)
+                {
+                    datagram_list.push_back({ i, 0, 0 });
+                }
+                ++datagram_list.back().count;
+                datagram_list.back().bytes += size;
+            }
+        };
+        // first fit decreasing, the lead packet fixed at the front of the
+        // first datagram. a packet lands in a later datagram only if it
+        // didn't fit the earlier ones when placed, and they've only filled
+        // up since, so split gives back the same datagrams.
+        auto pack(std::span<const std::span<const std::byte>> packets, std::size_t lead) -> void
+        {
+            by_size.clear();
+            for (std::size_t i = 0; i < packets.size(); ++i)
+            {
+                if (i != lead)
+                {
+                    by_size.push_back(i);
+                }
+            }
+            std::ranges::stable_sort(by_size, std::ranges::greater{}, [&](std::size_t i) { return packets[i].size(); });
+
+            bins.clear();
+            bin_of.assign(packets.size(), 0);
+            if (lead != packets.size())
+            {
+                bins.push_back(packets[lead].size());
+            }
+            for (std::size_t i : by_size)
+            {
+                std::size_t size = packets[i].size();
+                auto bin = std::ranges::find_if(bins, [&](std::size_t used) { return used + size <= last_mtu; });
+                if (bin == bins.end())
+                {
+                    bins.push_back(size);
+                    bin_of[i] = bins.size() - 1;
+                }
+                else
+                {
+                    *bin += size;
+                    bin_of[i] = std::size_t(bin - bins.begin());
+                }
+            }
+
+            // within a datagram, packets keep the order written.
+            for (std::size_t bin = 0; bin < bins.size(); ++bin)
+            {
+                datagram_list.push_back({ ordered.size(), 0, bins[bin] });
+                if (bin == 0 && lead != packets.size())
+                {
+                    ordered.push_back(packets[lead]);
+                }
+                for (std::size_t i = 0; i < packets.size(); ++i)
+                {
+                    if (i != lead && bin_of[i] == bin)
+                    {
+                        ordered.push_back(packets[i]);
+                    }
+                }
+                datagram_list.back().count = ordered.size() - datagram_list.back().first;
+            }
+        };
+
+        cigi::packing mode;
+        std::size_t last_mtu = 1;
+        std::vector<std::span<const std::byte>> ordered;
+        std::vector<frame_datagram> datagram_list;
+        // scratch for first fit decreasing.
+        std::vector<std::size_t> by_size;
+        std::vector<std::size_t> bins;
+        std::vector<std::size_t> bin_of;
+    };
+};
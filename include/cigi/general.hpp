@@ -1,9 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <initializer_list>
 #include <cstdint>
 #include <concepts>
 #include <limits>
 #include <vector>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <cstring>
 #include <ostream>
 
 namespace cigi
@@ -127,6 +134,9 @@ namespace cigi
         constexpr constant() = default;
         constexpr constant(const constant&) = default;
         constexpr constant(constant&&) noexcept = default;
+        // always the same value, so assigning is a no-op in effect, but it
+        // keeps the packets holding a constant<> copy-assignable by default.
+        constexpr auto operator =(const constant&) -> constant& = default;
         constexpr auto operator <=>(const constant&) const = default;
 
     private:
@@ -142,6 +152,370 @@ namespace cigi
     template <typename T>
     constexpr inline bool is_constant_v = is_constant<T>::value;
 
+    template <typename T>
+    struct is_bounded : std::false_type
+    {};
+    template <typename T, T lower, T upper>
+    struct is_bounded<bounded<T, lower, upper>> : std::true_type
+    {};
+    template <typename T>
+    constexpr inline bool is_bounded_v = is_bounded<T>::value;
+
+    // the type a member is stored as on the wire: bounded<> and constant<>
+    // collapse to their underlying arithmetic type.
+    template <typename T>
+    struct wire_type
+    {
+        using type = T;
+    };
+    template <typename T, T lower, T upper>
+    struct wire_type<bounded<T, lower, upper>>
+    {
+        using type = T;
+    };
+    template <typename T, T v>
+    struct wire_type<constant<T, v>>
+    {
+        using type = T;
+    };
+    template <typename T>
+    using wire_type_t = typename wire_type<T>::type;
+
+    enum class wire_t : u8
+    {
+        u8,
+        s8,
+        u16,
+        s16,
+        u32,
+        s32,
+        u64,
+        s64,
+        f32,
+        f64,
+    };
+
+    // one field of a packet's wire layout. every packet lists its fields in a
+    // constexpr table, from which generic code (byte swapping, validation,
+    // formatting, field access by name) is generated rather than hand-written.
+    struct field_descriptor
+    {
+        std::string_view name;
+        // byte offset from the start of the packet (or element).
+        u8 offset = 0;
+        // bytes occupied. bitfields report the 1 byte they share.
+        u8 size = 0;
+        wire_t type = wire_t::u8;
+        // position within the byte at offset, for bitfields. width 0 otherwise.
+        u8 bit_offset = 0;
+        u8 bit_width = 0;
+        // declared as constant<>, so it must hold constant_value on the wire.
+        bool constant = false;
+        u64 constant_value = 0;
+        bool reserved = false;
+        // a second name for bytes already described, e.g. the other side of a
+        // union. generic code skips these when walking the layout.
+        bool alias = false;
+        // declared as bounded<>, so it must be within [lower, upper].
+        bool bounded = false;
+        f64 lower = 0.0;
+        f64 upper = 0.0;
+        // for one side of a union: its bounds apply only while the selector
+        // bits (e.g. an entity control's attach state) pick that side.
+        bool selected = false;
+        u8 selector_offset = 0;
+        u8 selector_bit_offset = 0;
+        u8 selector_bit_width = 0;
+        u8 selector_value = 0;
+    };
+
+    template <typename T>
+    consteval auto to_wire_t() -> wire_t
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            return to_wire_t<std::underlying_type_t<T>>();
+        }
+        else if constexpr (std::same_as<T, bool>)
+        {
+            return wire_t::u8;
+        }
+        else if constexpr (std::floating_point<T>)
+        {
+            return sizeof(T) == 4 ? wire_t::f32 : wire_t::f64;
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            return sizeof(T) == 1 ? wire_t::s8 : sizeof(T) == 2 ? wire_t::s16 : sizeof(T) == 4 ? wire_t::s32 : wire_t::s64;
+        }
+        else
+        {
+            return sizeof(T) == 1 ? wire_t::u8 : sizeof(T) == 2 ? wire_t::u16 : sizeof(T) == 4 ? wire_t::u32 : wire_t::u64;
+        }
+    };
+
+    template <typename T>
+    consteval auto describe(std::string_view name, u8 offset) -> field_descriptor
+    {
+        using W = wire_type_t<T>;
+
+        field_descriptor field;
+        field.name = name;
+        field.offset = offset;
+        field.size = u8(sizeof(W));
+        field.type = to_wire_t<W>();
+        field.reserved = name.starts_with("reserved");
+        if constexpr (is_constant_v<T>)
+        {
+            field.constant = true;
+            field.constant_value = u64(T::value);
+        }
+        if constexpr (is_bounded_v<T>)
+        {
+            field.bounded = true;
+            field.lower = f64(T{ std::numeric_limits<W>::lowest() }.value);
+            field.upper = f64(T{ std::numeric_limits<W>::max() }.value);
+        }
+        return field;
+    };
+    template <typename T>
+    consteval auto describe_alias(std::string_view name, u8 offset) -> field_descriptor
+    {
+        auto field = describe<T>(name, offset);
+        field.alias = true;
+        return field;
+    };
+    // a field on the side of a union chosen when the bits at offset hold
+    // value, e.g. latitude while an entity control is detached.
+    template <typename T>
+    consteval auto describe_selected(std::string_view name, u8 offset, u8 selector_offset, u8 selector_bit_offset, u8 selector_bit_width, u8 selector_value) -> field_descriptor
+    {
+        auto field = describe<T>(name, offset);
+        field.selected = true;
+        field.selector_offset = selector_offset;
+        field.selector_bit_offset = selector_bit_offset;
+        field.selector_bit_width = selector_bit_width;
+        field.selector_value = selector_value;
+        return field;
+    };
+    template <typename T>
+    consteval auto describe_bits(std::string_view name, u8 offset, u8 bit_offset, u8 bit_width) -> field_descriptor
+    {
+        field_descriptor field;
+        field.name = name;
+        field.offset = offset;
+        field.size = 1;
+        field.type = wire_t::u8;
+        field.bit_offset = bit_offset;
+        field.bit_width = bit_width;
+        field.reserved = name.starts_with("reserved");
+        return field;
+    };
+
+    // a vector with its capacity fixed at compile time and its elements stored
+    // inline, for the repeating payloads of variable-length packets. it's
+    // trivially copyable when T is, so those packets are too.
+    template <typename T, std::size_t N>
+    requires (N <= 255)
+    struct inline_vector
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        constexpr inline_vector() = default;
+        constexpr inline_vector(std::initializer_list<T> values) :
+            count{ u8(std::min(values.size(), N)) }
+        {
+            std::copy(values.begin(), values.begin() + count, elements.begin());
+        };
+
+        [[nodiscard]]
+        static constexpr auto capacity() noexcept -> std::size_t
+        {
+            return N;
+        };
+        [[nodiscard]]
+        constexpr auto size() const noexcept -> std::size_t
+        {
+            return count;
+        };
+        [[nodiscard]]
+        constexpr auto empty() const noexcept -> bool
+        {
+            return count == 0;
+        };
+        [[nodiscard]]
+        constexpr auto full() const noexcept -> bool
+        {
+            return count == N;
+        };
+
+        constexpr auto data() noexcept -> T*
+        {
+            return elements.data();
+        };
+        constexpr auto data() const noexcept -> const T*
+        {
+            return elements.data();
+        };
+        constexpr auto begin() noexcept -> iterator
+        {
+            return elements.data();
+        };
+        constexpr auto end() noexcept -> iterator
+        {
+            return elements.data() + count;
+        };
+        constexpr auto begin() const noexcept -> const_iterator
+        {
+            return elements.data();
+        };
+        constexpr auto end() const noexcept -> const_iterator
+        {
+            return elements.data() + count;
+        };
+        constexpr auto operator [](std::size_t i) noexcept -> T&
+        {
+            return elements[i];
+        };
+        constexpr auto operator [](std::size_t i) const noexcept -> const T&
+        {
+            return elements[i];
+        };
+
+        // false, changing nothing, when full.
+        constexpr auto push_back(const T& value) noexcept -> bool
+        {
+            if (full())
+            {
+                return false;
+            }
+            elements[count++] = value;
+            return true;
+        };
+        constexpr auto clear() noexcept -> void
+        {
+            count = 0;
+        };
+        // new elements are set to value. sizes beyond capacity are clamped.
+        constexpr auto resize(std::size_t size, const T& value = T{}) noexcept -> void
+        {
+            size = std::min(size, N);
+            for (std::size_t i = count; i < size; ++i)
+            {
+                elements[i] = value;
+            }
+            count = u8(size);
+        };
+
+        friend constexpr auto operator ==(const inline_vector& a, const inline_vector& b) -> bool
+        {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end());
+        };
+
+    private:
+        std::array<T, N> elements{};
+        u8 count = 0;
+    };
+
+    // inline, fixed-capacity storage for one packet. packet_size is a u8, so
+    // no packet is more than 255 bytes and this never needs the heap. copies
+    // and moves copy only the bytes in use.
+    struct packet_buffer
+    {
+        static constexpr std::size_t capacity = 256;
+
+        using value_type = std::byte;
+        using size_type = std::size_t;
+        using iterator = std::byte*;
+        using const_iterator = const std::byte*;
+
+        packet_buffer() = default;
+        // count zeroed bytes, at most capacity.
+        explicit packet_buffer(std::size_t count) noexcept :
+            count{ u16(std::min(count, capacity)) }
+        {
+            std::memset(bytes.data(), 0, this->count);
+        };
+        // a copy of the first capacity bytes at most.
+        packet_buffer(const std::byte* source, std::size_t count) noexcept :
+            count{ u16(std::min(count, capacity)) }
+        {
+            std::memcpy(bytes.data(), source, this->count);
+        };
+        packet_buffer(const packet_buffer& other) noexcept :
+            count{ other.count }
+        {
+            std::memcpy(bytes.data(), other.bytes.data(), count);
+        };
+        auto operator =(const packet_buffer& other) noexcept -> packet_buffer&
+        {
+            count = other.count;
+            std::memmove(bytes.data(), other.bytes.data(), count);
+            return *this;
+        };
+
+        // replaces the contents with a copy of the first capacity bytes at most.
+        auto assign(const std::byte* source, std::size_t count) noexcept -> void
+        {
+            this->count = u16(std::min(count, capacity));
+            std::memmove(bytes.data(), source, this->count);
+        };
+
+        [[nodiscard]]
+        auto data() noexcept -> std::byte*
+        {
+            return bytes.data();
+        };
+        [[nodiscard]]
+        auto data() const noexcept -> const std::byte*
+        {
+            return bytes.data();
+        };
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return count;
+        };
+        [[nodiscard]]
+        auto empty() const noexcept -> bool
+        {
+            return count == 0;
+        };
+
+        auto begin() noexcept -> iterator
+        {
+            return data();
+        };
+        auto end() noexcept -> iterator
+        {
+            return data() + count;
+        };
+        auto begin() const noexcept -> const_iterator
+        {
+            return data();
+        };
+        auto end() const noexcept -> const_iterator
+        {
+            return data() + count;
+        };
+
+        auto operator [](std::size_t i) noexcept -> std::byte&
+        {
+            return bytes[i];
+        };
+        auto operator [](std::size_t i) const noexcept -> const std::byte&
+        {
+            return bytes[i];
+        };
+
+    private:
+        alignas(8) std::array<std::byte, capacity> bytes;
+        u16 count = 0;
+    };
+
     struct serialized_data
     {
         // flags
@@ -153,6 +527,12 @@ namespace cigi
             non_constant_packet_size    = 1 << 0,
             // mismatched packet id, packet size, or major version.
             mismatched_constant         = 1 << 1,
+            // the destination given to serialize_into can't hold the packet.
+            insufficient_buffer         = 1 << 2,
+            // a bounded<> field holds a value outside its bounds.
+            out_of_bounds               = 1 << 3,
+            // fewer bytes than the packet's layout needs.
+            truncated_packet            = 1 << 4,
         };
 
         union pointer
@@ -198,24 +578,26 @@ namespace cigi
         
         template <u8 L, u8 H>
         serialized_data(bounded<u8, L, H> size) :
-            data{ size, std::byte{} },
+            data{ std::size_t(size) },
             p{ data.data() }
         {};
         template <u8 sz>
         serialized_data(constant<u8, sz> size) :
-            data{ size, std::byte{} },
+            data{ std::size_t(size) },
             p{ data.data() }
         {};
         serialized_data(u8 size) :
-            data{ size, std::byte{} },
+            data{ std::size_t(size) },
             p{ data.data() }
         {};
+        // packets are at most 255 bytes, so anything past the buffer's
+        // capacity is dropped.
         explicit serialized_data(const std::byte* bytes, std::size_t count) :
-            data{ bytes, bytes + count },
+            data{ bytes, count },
             p{ data.data() }
         {};
         explicit serialized_data(const std::vector<std::byte>& data) :
-            data{ data },
+            data{ data.data(), data.size() },
             p{ this->data.data() }
         {};
 
@@ -370,16 +752,97 @@ namespace cigi
             return data.data();
         };
 
-        std::vector<std::byte> data;
+        packet_buffer data;
         pointer p;
     };
 
+    // non-owning counterpart to serialized_data, for writing a packet straight
+    // into a caller-owned buffer. bounds are checked once by the caller of the
+    // stream operators, not on every write.
+    struct serialized_span
+    {
+        explicit serialized_span(std::span<std::byte> data) :
+            data{ data },
+            p{ data.data() }
+        {};
+
+        auto operator <<(const octet& value) -> serialized_span&
+        {
+            *p._octet++ = value;
+            return *this;
+        };
+        auto operator <<(const u8& value) -> serialized_span&
+        {
+            *p._u8++ = value;
+            return *this;
+        };
+        auto operator <<(const s8& value) -> serialized_span&
+        {
+            *p._s8++ = value;
+            return *this;
+        };
+        auto operator <<(const u16& value) -> serialized_span&
+        {
+            *p._u16++ = value;
+            return *this;
+        };
+        auto operator <<(const s16& value) -> serialized_span&
+        {
+            *p._s16++ = value;
+            return *this;
+        };
+        auto operator <<(const u32& value) -> serialized_span&
+        {
+            *p._u32++ = value;
+            return *this;
+        };
+        auto operator <<(const s32& value) -> serialized_span&
+        {
+            *p._s32++ = value;
+            return *this;
+        };
+        auto operator <<(const u64& value) -> serialized_span&
+        {
+            *p._u64++ = value;
+            return *this;
+        };
+        auto operator <<(const s64& value) -> serialized_span&
+        {
+            *p._s64++ = value;
+            return *this;
+        };
+        auto operator <<(const f32& value) -> serialized_span&
+        {
+            *p._f32++ = value;
+            return *this;
+        };
+        auto operator <<(const f64& value) -> serialized_span&
+        {
+            *p._f64++ = value;
+            return *this;
+        };
+
+        // number of bytes written so far.
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t
+        {
+            return std::size_t(p.base - data.data());
+        };
+
+        std::span<std::byte> data;
+        serialized_data::pointer p;
+    };
+
     using serialize_result = std::pair<serialized_data, serialized_data::errors>;
+    // bytes written into the destination, and any errors. nothing is written
+    // unless errors is none.
+    using serialize_into_result = std::pair<std::size_t, serialized_data::errors>;
 
     template <typename T>
     concept cigi_packet = requires (T t)
     {
         { T::serialize(t) } -> std::same_as<serialize_result>;
+        { T::serialize_into(t, std::declval<std::span<std::byte>>()) } -> std::same_as<serialize_into_result>;
         { T::deserialize(std::declval<serialized_data&>(), t) } -> std::same_as<serialized_data::errors>;
         requires is_constant_v<decltype(T::packet_id)>;
         requires std::same_as<u8, typename decltype(T::packet_id)::value_type>;
@@ -411,9 +874,33 @@ namespace cigi
         requires is_constant_v<decltype(T::packet_size)>;
         requires sizeof(T) == t.packet_size;
     }
+    [[nodiscard]]
+    auto default_serialize_into(const T& data, std::span<std::byte> buffer) -> serialize_into_result
+    {
+        if (buffer.size() < data.packet_size)
+        {
+            return std::make_pair(std::size_t{ 0 }, serialized_data::errors::insufficient_buffer);
+        }
+
+        std::memcpy(buffer.data(), &data, data.packet_size);
+        return std::make_pair(std::size_t{ data.packet_size }, serialized_data::errors::none);
+    };
+    template <cigi_packet T>
+    requires requires (T t)
+    {
+        requires is_constant_v<decltype(T::packet_size)>;
+        requires sizeof(T) == t.packet_size;
+    }
     auto default_deserialize(serialized_data& data, T& packet) -> serialized_data::errors
     {
-        std::copy(data.data.begin(), data.data.end(), (std::byte*)(&packet));
+        // bytes past sizeof(T) are ignored, per the standard, for backwards
+        // compatibility. too few would leave the packet half-read.
+        if (data.size() < sizeof(T))
+        {
+            return serialized_data::errors::truncated_packet;
+        }
+
+        std::memcpy((void*)(&packet), data.start_pointer(), sizeof(T));
         return serialized_data::errors::none;
     };
 };
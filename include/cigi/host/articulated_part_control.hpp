@@ -36,11 +36,37 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const articulated_part_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, articulated_part_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 19> fields = {
+            describe<constant<u8, 6>>("packet_id", 0),
+            describe<constant<u8, 32>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe<u8>("articulated_part_id", 4),
+            describe_bits<enable_t>("articulated_part_enable", 5, 0, 1),
+            describe_bits<enable_t>("x_offset_enable", 5, 1, 1),
+            describe_bits<enable_t>("y_offset_enable", 5, 2, 1),
+            describe_bits<enable_t>("z_offset_enable", 5, 3, 1),
+            describe_bits<enable_t>("roll_enable", 5, 4, 1),
+            describe_bits<enable_t>("pitch_enable", 5, 5, 1),
+            describe_bits<enable_t>("yaw_enable", 5, 6, 1),
+            describe_bits<u8>("reserved_0", 5, 7, 1),
+            describe<constant<u16, 0>>("reserved_1", 6),
+            describe<f32>("x_offset", 8),
+            describe<f32>("y_offset", 12),
+            describe<f32>("z_offset", 16),
+            describe<bounded<f32, -180.f, 180.f>>("roll", 20),
+            describe<bounded<f32, -90.f, 90.f>>("pitch", 24),
+            describe<bounded<f32, 0.f, 360.f>>("yaw", 28),
+        };
+
         constant<u8, 6> packet_id;
         constant<u8, 32> packet_size;
         u16 entity_id = 0;
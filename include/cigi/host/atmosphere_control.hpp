@@ -29,11 +29,30 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const atmosphere_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, atmosphere_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 12> fields = {
+            describe<constant<u8, 10>>("packet_id", 0),
+            describe<constant<u8, 32>>("packet_size", 1),
+            describe_bits<enable_t>("atmospheric_model_enable", 2, 0, 1),
+            describe_bits<u8>("reserved_0", 2, 1, 7),
+            describe<bounded<u8, 0, 100>>("global_humidity", 3),
+            describe<f32>("global_air_temperature", 4),
+            describe<bounded<f32, 0.f>>("global_visibility_range", 8),
+            describe<bounded<f32, 0.f>>("global_horizontal_wind_speed", 12),
+            describe<f32>("global_vertical_wind_speed", 16),
+            describe<bounded<f32, 0.f, 360.f>>("global_wind_direction", 20),
+            describe<bounded<f32, 0.f>>("global_barometric_pressure", 24),
+            describe<constant<u32, 0>>("reserved_1", 28),
+        };
+
         constant<u8, 10> packet_id;
         constant<u8, 32> packet_size;
         enable_t atmospheric_model_enable : 1 = enable_t::disabled;
@@ -30,11 +30,32 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const celestial_sphere_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, celestial_sphere_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 14> fields = {
+            describe<constant<u8, 9>>("packet_id", 0),
+            describe<constant<u8, 16>>("packet_size", 1),
+            describe<bounded<u8, 0, 23>>("hour", 2),
+            describe<bounded<u8, 0, 59>>("minute", 3),
+            describe_bits<enable_t>("ephemeris_model_enable", 4, 0, 1),
+            describe_bits<enable_t>("sun_enable", 4, 1, 1),
+            describe_bits<enable_t>("moon_enable", 4, 2, 1),
+            describe_bits<enable_t>("star_field_enable", 4, 3, 1),
+            describe_bits<valid_t>("date_time_valid", 4, 4, 1),
+            describe_bits<u8>("reserved_0", 4, 5, 3),
+            describe<u8>("reserved_1", 5),
+            describe<u16>("reserved_2", 6),
+            describe<u32>("date", 8),
+            describe<bounded<f32, 0.f, 100.f>>("star_field_intensity", 12),
+        };
+
         constant<u8, 9> packet_id;
         constant<u8, 16> packet_size;
         bounded<u8, 0, 23> hour = 0;
@@ -31,11 +31,33 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const collision_detection_segment_definition& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, collision_detection_segment_definition& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 15> fields = {
+            describe<constant<u8, 22>>("packet_id", 0),
+            describe<constant<u8, 40>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe<u8>("segment_id", 4),
+            describe_bits<enable_t>("segment_enable", 5, 0, 1),
+            describe_bits<u8>("reserved_0", 5, 1, 7),
+            describe<constant<u16, 0>>("reserved_1", 6),
+            describe<f32>("x1", 8),
+            describe<f32>("y1", 12),
+            describe<f32>("z1", 16),
+            describe<f32>("x2", 20),
+            describe<f32>("y2", 24),
+            describe<f32>("z2", 28),
+            describe<u32>("material_mask", 32),
+            describe<constant<u32, 0>>("reserved_2", 36),
+        };
+
         constant<u8, 22> packet_id;
         constant<u8, 40> packet_size;
         u16 entity_id = 0;
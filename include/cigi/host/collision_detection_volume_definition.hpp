@@ -40,11 +40,37 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const collision_detection_volume_definition& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, collision_detection_volume_definition& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 19> fields = {
+            describe<constant<u8, 23>>("packet_id", 0),
+            describe<constant<u8, 48>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe<u8>("volume_id", 4),
+            describe_bits<enable_t>("volume_enable", 5, 0, 1),
+            describe_bits<volume_type_t>("volume_type", 5, 1, 1),
+            describe_bits<u8>("reserved_0", 5, 2, 6),
+            describe<constant<u16, 0>>("reserved_1", 6),
+            describe<f32>("x", 8),
+            describe<f32>("y", 12),
+            describe<f32>("z", 16),
+            describe<bounded<f32, 0.f>>("height", 20),
+            describe_alias<bounded<f32, 0.f>>("radius", 20),
+            describe<bounded<f32, 0.f>>("width", 24),
+            describe<bounded<f32, 0.f>>("depth", 28),
+            describe<bounded<f32, -180.f, 180.f>>("roll", 32),
+            describe<bounded<f32, -90.f, 90.f>>("pitch", 36),
+            describe<bounded<f32, 0.f, 360.f>>("yaw", 40),
+            describe<constant<u32, 0>>("reserved_2", 44),
+        };
+
         constant<u8, 23> packet_id;
         constant<u8, 48> packet_size;
         u16 entity_id = 0;
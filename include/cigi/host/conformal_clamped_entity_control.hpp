@@ -25,11 +25,24 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const conformal_clamped_entity_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, conformal_clamped_entity_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 6> fields = {
+            describe<constant<u8, 3>>("packet_id", 0),
+            describe<constant<u8, 24>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe<bounded<f32, 0.f, 360.f>>("yaw", 4),
+            describe<bounded<f64, -90.0, 90.0>>("latitude", 8),
+            describe<bounded<f64, -180.0, 180.0>>("longitude", 16),
+        };
+
         constant<u8, 3> packet_id;
         constant<u8, 24> packet_size;
         u16 entity_id = 0;
@@ -24,11 +24,26 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const earth_reference_model_definition& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, earth_reference_model_definition& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 8> fields = {
+            describe<constant<u8, 19>>("packet_id", 0),
+            describe<constant<u8, 24>>("packet_size", 1),
+            describe_bits<enable_t>("custom_erm_enable", 2, 0, 1),
+            describe_bits<u8>("reserved_0", 2, 1, 7),
+            describe<constant<u8, 0>>("reserved_1", 3),
+            describe<constant<u32, 0>>("reserved_2", 4),
+            describe<f64>("equatorial_radius", 8),
+            describe<f64>("flattening", 16),
+        };
+
         constant<u8, 19> packet_id;
         constant<u8, 24> packet_size;
         enable_t custom_erm_enable : 1 = enable_t::disabled;
@@ -64,11 +64,45 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const entity_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, entity_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 27> fields = {
+            describe<constant<u8, 2>>("packet_id", 0),
+            describe<constant<u8, 48>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe_bits<active_t>("entity_state", 4, 0, 2),
+            describe_bits<attach_t>("attach_state", 4, 2, 1),
+            describe_bits<enable_t>("collision_detection_enable", 4, 3, 1),
+            describe_bits<inherit_t>("inherit_alpha", 4, 4, 1),
+            describe_bits<ground_ocean_clamp_t>("ground_ocean_clamp", 4, 5, 2),
+            describe_bits<u8>("reserved_0", 4, 7, 1),
+            describe_bits<animation_direction_t>("animation_direction", 5, 0, 1),
+            describe_bits<animation_loop_mode_t>("animation_loop_mode", 5, 1, 1),
+            describe_bits<animation_state_t>("animation_state", 5, 2, 2),
+            describe_bits<enable_t>("linear_extrapolation_interpolation_enable", 5, 4, 1),
+            describe_bits<u8>("reserved_1", 5, 5, 3),
+            describe<u8>("alpha", 6),
+            describe<constant<u8, 0>>("reserved_2", 7),
+            describe<u16>("entity_type", 8),
+            describe<u16>("parent_id", 10),
+            describe<bounded<f32, -180.f, 180.f>>("roll", 12),
+            describe<bounded<f32, -90.f, 90.f>>("pitch", 16),
+            describe<bounded<f32, 0.f, 360.f>>("yaw", 20),
+            describe_selected<bounded<f64, -90.0, 90.0>>("latitude", 24, 4, 2, 1, 0),
+            describe_alias<f64>("x_offset", 24),
+            describe_selected<bounded<f64, -180.0, 180.0>>("longitude", 32, 4, 2, 1, 0),
+            describe_alias<f64>("y_offset", 32),
+            describe<f64>("altitude", 40),
+            describe_alias<f64>("z_offset", 40),
+        };
+
         constant<u8, 2> packet_id;
         constant<u8, 48> packet_size;
         u16 entity_id = 0;
@@ -37,11 +37,27 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const environmental_conditions_request& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, environmental_conditions_request& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 9> fields = {
+            describe<constant<u8, 28>>("packet_id", 0),
+            describe<constant<u8, 32>>("packet_size", 1),
+            describe_bits<request_type_t>("request_type", 2, 0, 4),
+            describe_bits<u8>("reserved_0", 2, 4, 4),
+            describe<u8>("request_id", 3),
+            describe<constant<u32, 0>>("reserved_1", 4),
+            describe<bounded<f64, -90.0, 90.0>>("latitude", 8),
+            describe<bounded<f64, -180.0, 180.0>>("longitude", 16),
+            describe<f64>("altitude", 24),
+        };
+
         constant<u8, 28> packet_id;
         constant<u8, 32> packet_size;
         request_type_t request_type : 4 = request_type_t::none;
@@ -33,11 +33,37 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const environmental_region_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, environmental_region_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 19> fields = {
+            describe<constant<u8, 11>>("packet_id", 0),
+            describe<constant<u8, 48>>("packet_size", 1),
+            describe<u16>("region_id", 2),
+            describe_bits<active_t>("region_state", 4, 0, 2),
+            describe_bits<merge_t>("merge_weather_properties", 4, 2, 1),
+            describe_bits<merge_t>("merge_aerosol_concentrations", 4, 3, 1),
+            describe_bits<merge_t>("merge_maritime_surface_conditions", 4, 4, 1),
+            describe_bits<merge_t>("merge_terrestrial_surface_conditions", 4, 5, 1),
+            describe_bits<u8>("reserved_0", 4, 6, 2),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<constant<u16, 0>>("reserved_2", 6),
+            describe<bounded<f64, -90.0, 90.0>>("latitude", 8),
+            describe<bounded<f64, -180.0, 180.0>>("longitude", 16),
+            describe<bounded<f32, 0.f>>("size_x", 24),
+            describe<bounded<f32, 0.f>>("size_y", 28),
+            describe<bounded<f32, 0.f>>("corner_radius", 32),
+            describe<bounded<f32, -180.f, 180.f>>("rotation", 36),
+            describe<bounded<f32, 0.f>>("transition_perimeter", 40),
+            describe<constant<u32, 0>>("reserved_3", 44),
+        };
+
         constant<u8, 11> packet_id;
         constant<u8, 48> packet_size;
         u16 region_id = 0;
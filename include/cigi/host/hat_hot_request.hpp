@@ -36,11 +36,32 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const hat_hot_request& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, hat_hot_request& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 14> fields = {
+            describe<constant<u8, 24>>("packet_id", 0),
+            describe<constant<u8, 32>>("packet_size", 1),
+            describe<u16>("hat_hod_id", 2),
+            describe_bits<request_type_t>("request_type", 4, 0, 2),
+            describe_bits<coordinate_system_t>("coordinate_system", 4, 2, 1),
+            describe_bits<u8>("reserved_0", 4, 3, 5),
+            describe<u8>("update_period", 5),
+            describe<u16>("entity_id", 6),
+            describe_selected<bounded<f64, -90.0, 90.0>>("latitude", 8, 4, 2, 1, 0),
+            describe_alias<f64>("x_offset", 8),
+            describe_selected<bounded<f64, -180.0, 180.0>>("longitude", 16, 4, 2, 1, 0),
+            describe_alias<f64>("y_offset", 16),
+            describe<f64>("altitude", 24),
+            describe_alias<f64>("z_offset", 24),
+        };
+
         constant<u8, 24> packet_id;
         constant<u8, 32> packet_size;
         u16 hat_hod_id = 0;
@@ -36,11 +36,32 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const ig_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, ig_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 14> fields = {
+            describe<constant<u8, 1>>("packet_id", 0),
+            describe<constant<u8, 24>>("packet_size", 1),
+            describe<constant<u8, 3>>("major_version", 2),
+            describe<bounded<s8, 0, 127>>("database_number", 3),
+            describe_bits<ig_mode_t>("ig_mode", 4, 0, 2),
+            describe_bits<valid_t>("timestamp_valid", 4, 2, 1),
+            describe_bits<enable_t>("extrapolation_interpolation_enable", 4, 3, 1),
+            describe_bits<u8>("minor_version", 4, 4, 4),
+            describe<constant<u8, 0>>("reserved_0", 5),
+            describe<constant<u16, 0x8000>>("byte_swap_magic_number", 6),
+            describe<u32>("host_frame_number", 8),
+            describe<u32>("timestamp", 12),
+            describe<u32>("last_ig_frame_number", 16),
+            describe<constant<u32, 0>>("reserved_1", 20),
+        };
+
         constant<u8, 1> packet_id;
         constant<u8, 24> packet_size;
         constant<u8, 3> major_version;
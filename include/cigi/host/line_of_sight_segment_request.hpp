@@ -38,11 +38,45 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const line_of_sight_segment_request& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, line_of_sight_segment_request& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 27> fields = {
+            describe<constant<u8, 25>>("packet_id", 0),
+            describe<constant<u8, 64>>("packet_size", 1),
+            describe<u16>("los_id", 2),
+            describe_bits<request_type_t>("request_type", 4, 0, 1),
+            describe_bits<coordinate_system_t>("source_point_coordinate_system", 4, 1, 1),
+            describe_bits<coordinate_system_t>("destination_point_coordinate_system", 4, 2, 1),
+            describe_bits<coordinate_system_t>("response_coordinate_system", 4, 3, 1),
+            describe_bits<valid_t>("destination_entity_id_valid", 4, 4, 1),
+            describe_bits<u8>("reserved_0", 4, 5, 3),
+            describe<u8>("alpha_threshold", 5),
+            describe<u16>("source_entity_id", 6),
+            describe_selected<bounded<f64, -90.0, 90.0>>("source.latitude", 8, 4, 1, 1, 0),
+            describe_alias<f64>("source.x_offset", 8),
+            describe_selected<bounded<f64, -180.0, 180.0>>("source.longitude", 16, 4, 1, 1, 0),
+            describe_alias<f64>("source.y_offset", 16),
+            describe<f64>("source.altitude", 24),
+            describe_alias<f64>("source.z_offset", 24),
+            describe_selected<bounded<f64, -90.0, 90.0>>("destination.latitude", 32, 4, 2, 1, 0),
+            describe_alias<f64>("destination.x_offset", 32),
+            describe_selected<bounded<f64, -180.0, 180.0>>("destination.longitude", 40, 4, 2, 1, 0),
+            describe_alias<f64>("destination.y_offset", 40),
+            describe<f64>("destination.altitude", 48),
+            describe_alias<f64>("destination.z_offset", 48),
+            describe<u32>("material_mask", 56),
+            describe<u8>("update_period", 60),
+            describe<constant<u8, 0>>("reserved_1", 61),
+            describe<u16>("destination_entity_id", 62),
+        };
+
         constant<u8, 25> packet_id;
         constant<u8, 64> packet_size;
         u16 los_id = 0;
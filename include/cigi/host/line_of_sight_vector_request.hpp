@@ -36,11 +36,41 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const line_of_sight_vector_request& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, line_of_sight_vector_request& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 23> fields = {
+            describe<constant<u8, 26>>("packet_id", 0),
+            describe<constant<u8, 56>>("packet_size", 1),
+            describe<u16>("los_id", 2),
+            describe_bits<request_type_t>("request_type", 4, 0, 1),
+            describe_bits<coordinate_system_t>("source_point_coordinate_system", 4, 1, 1),
+            describe_bits<coordinate_system_t>("response_coordinate_system", 4, 2, 1),
+            describe_bits<u8>("reserved_0", 4, 3, 5),
+            describe<u8>("alpha_threshold", 5),
+            describe<u16>("entity_id", 6),
+            describe<bounded<f32, -180.f, 180.f>>("azimuth", 8),
+            describe<bounded<f32, -90.f, 90.f>>("elevation", 12),
+            describe<bounded<f32, 0.f>>("minimum_range", 16),
+            describe<bounded<f32, 0.f>>("maximum_range", 20),
+            describe_selected<bounded<f64, -90.0, 90.0>>("source.latitude", 24, 4, 1, 1, 0),
+            describe_alias<f64>("source.x_offset", 24),
+            describe_selected<bounded<f64, -180.0, 180.0>>("source.longitude", 32, 4, 1, 1, 0),
+            describe_alias<f64>("source.y_offset", 32),
+            describe<f64>("source.altitude", 40),
+            describe_alias<f64>("source.z_offset", 40),
+            describe<u32>("material_mask", 48),
+            describe<u8>("update_period", 52),
+            describe<constant<u8, 0>>("reserved_1", 53),
+            describe<constant<u16, 0>>("reserved_2", 54),
+        };
+
         constant<u8, 26> packet_id;
         constant<u8, 56> packet_size;
         u16 los_id = 0;
@@ -28,11 +28,32 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const maritime_surface_conditions_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, maritime_surface_conditions_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 14> fields = {
+            describe<constant<u8, 13>>("packet_id", 0),
+            describe<constant<u8, 24>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe_alias<u16>("region_id", 2),
+            describe_bits<enable_t>("surface_conditions_enable", 4, 0, 1),
+            describe_bits<enable_t>("whitecap_enable", 4, 1, 1),
+            describe_bits<scope_t>("scope", 4, 2, 2),
+            describe_bits<u8>("reserved_0", 4, 4, 4),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<constant<u16, 0>>("reserved_2", 6),
+            describe<f32>("sea_surface_height", 8),
+            describe<f32>("surface_water_temperature", 12),
+            describe<bounded<f32, 0.f, 100.f>>("surface_clarity", 16),
+            describe<constant<u32, 0>>("reserved_3", 20),
+        };
+
         constant<u8, 13> packet_id;
         constant<u8, 24> packet_size;
         union
@@ -38,11 +38,34 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const motion_tracker_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, motion_tracker_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 16> fields = {
+            describe<constant<u8, 18>>("packet_id", 0),
+            describe<constant<u8, 8>>("packet_size", 1),
+            describe<u16>("view_id", 2),
+            describe_alias<u16>("view_group_id", 2),
+            describe<u8>("tracker_id", 4),
+            describe_bits<enable_t>("tracker_enable", 5, 0, 1),
+            describe_bits<enable_t>("boresight_enable", 5, 1, 1),
+            describe_bits<enable_t>("x_enable", 5, 2, 1),
+            describe_bits<enable_t>("y_enable", 5, 3, 1),
+            describe_bits<enable_t>("z_enable", 5, 4, 1),
+            describe_bits<enable_t>("roll_enable", 5, 5, 1),
+            describe_bits<enable_t>("pitch_enable", 5, 6, 1),
+            describe_bits<enable_t>("yaw_enable", 5, 7, 1),
+            describe_bits<view_t>("view_select", 6, 0, 1),
+            describe_bits<u8>("reserved_0", 6, 1, 7),
+            describe<constant<u8, 0>>("reserved_1", 7),
+        };
+
         constant<u8, 18> packet_id;
         constant<u8, 8> packet_size;
         union
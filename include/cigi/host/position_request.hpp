@@ -46,11 +46,27 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const position_request& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, position_request& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 9> fields = {
+            describe<constant<u8, 27>>("packet_id", 0),
+            describe<constant<u8, 8>>("packet_size", 1),
+            describe<u16>("object_id", 2),
+            describe<u8>("articulated_part_id", 4),
+            describe_bits<update_mode_t>("update_mode", 5, 0, 1),
+            describe_bits<object_class_t>("object_class", 5, 1, 3),
+            describe_bits<coordinate_system_t>("coordinate_system", 5, 4, 2),
+            describe_bits<u8>("reserved_1", 5, 6, 2),
+            describe<constant<u16, 0>>("reserved_2", 6),
+        };
+
         constant<u8, 27> packet_id;
         constant<u8, 8> packet_size;
         u16 object_id = 0;
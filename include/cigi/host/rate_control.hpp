@@ -38,11 +38,32 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const rate_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, rate_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 14> fields = {
+            describe<constant<u8, 8>>("packet_id", 0),
+            describe<constant<u8, 32>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe<u8>("articulated_part_id", 4),
+            describe_bits<bool>("apply_to_articulated_part", 5, 0, 1),
+            describe_bits<coordinate_system_t>("coordinate_system", 5, 1, 1),
+            describe_bits<u8>("reserved_0", 5, 2, 6),
+            describe<u16>("reserved_1", 6),
+            describe<f32>("x_linear_rate", 8),
+            describe<f32>("y_linear_rate", 12),
+            describe<f32>("z_linear_rate", 16),
+            describe<f32>("roll_angular_rate", 20),
+            describe<f32>("pitch_angular_rate", 24),
+            describe<f32>("yaw_angular_rate", 28),
+        };
+
         constant<u8, 8> packet_id;
         constant<u8, 32> packet_size;
         u16 entity_id = 0;
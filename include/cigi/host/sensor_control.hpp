@@ -63,11 +63,35 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const sensor_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, sensor_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 17> fields = {
+            describe<constant<u8, 17>>("packet_id", 0),
+            describe<constant<u8, 24>>("packet_size", 1),
+            describe<u16>("view_id", 2),
+            describe<u8>("sensor_id", 4),
+            describe_bits<on_off_t>("sensor_on_off", 5, 0, 1),
+            describe_bits<polarity_t>("polarity", 5, 1, 1),
+            describe_bits<enable_t>("line_by_line_dropout_enable", 5, 2, 1),
+            describe_bits<enable_t>("automatic_gain", 5, 3, 1),
+            describe_bits<track_white_black_t>("track_white_black", 5, 4, 1),
+            describe_bits<track_mode_t>("track_mode", 5, 5, 3),
+            describe_bits<response_type_t>("response_type", 6, 0, 1),
+            describe_bits<u8>("reserved_0", 6, 1, 7),
+            describe<constant<u8, 0>>("reserved_1", 7),
+            describe<bounded<f32, 0.f, 1.f>>("gain", 8),
+            describe<bounded<f32, 0.f, 1.f>>("level", 12),
+            describe<bounded<f32, 0.f>>("ac_coupling", 16),
+            describe<bounded<f32, 0.f, 1.f>>("noise", 20),
+        };
+
         constant<u8, 17> packet_id;
         constant<u8, 24> packet_size;
         u16 view_id = 0;
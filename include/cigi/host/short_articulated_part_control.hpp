@@ -50,11 +50,40 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const short_articulated_part_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, short_articulated_part_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 22> fields = {
+            describe<constant<u8, 7>>("packet_id", 0),
+            describe<constant<u8, 16>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe<u8>("articulated_part_id[0]", 4),
+            describe<u8>("articulated_part_id[1]", 5),
+            describe_bits<dof_select_t>("dof_select_1", 6, 0, 3),
+            describe_bits<dof_select_t>("dof_select_2", 6, 3, 3),
+            describe_bits<enable_t>("articulated_part_enable_1", 6, 6, 1),
+            describe_bits<enable_t>("articulated_part_enable_2", 6, 7, 1),
+            describe<constant<u8, 0>>("reserved_0", 7),
+            describe<f32>("dof[0].x_offset", 8),
+            describe_alias<f32>("dof[0].y_offset", 8),
+            describe_alias<f32>("dof[0].z_offset", 8),
+            describe_alias<bounded<f32, 0.f, 360.f>>("dof[0].yaw", 8),
+            describe_alias<bounded<f32, -90.f, 90.f>>("dof[0].pitch", 8),
+            describe_alias<bounded<f32, -180.f, 180.f>>("dof[0].roll", 8),
+            describe<f32>("dof[1].x_offset", 12),
+            describe_alias<f32>("dof[1].y_offset", 12),
+            describe_alias<f32>("dof[1].z_offset", 12),
+            describe_alias<bounded<f32, 0.f, 360.f>>("dof[1].yaw", 12),
+            describe_alias<bounded<f32, -90.f, 90.f>>("dof[1].pitch", 12),
+            describe_alias<bounded<f32, -180.f, 180.f>>("dof[1].roll", 12),
+        };
+
         constant<u8, 7> packet_id;
         constant<u8, 16> packet_size;
         u16 entity_id = 0;
@@ -28,11 +28,27 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const short_component_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, short_component_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 9> fields = {
+            describe<constant<u8, 5>>("packet_id", 0),
+            describe<constant<u8, 16>>("packet_size", 1),
+            describe<u16>("component_id", 2),
+            describe<u16>("instance_id", 4),
+            describe_bits<component_control::component_class_t>("component_class", 6, 0, 6),
+            describe_bits<u8>("reserved_0", 6, 6, 2),
+            describe<u8>("component_state", 7),
+            describe<u32>("component_data[0]", 8),
+            describe<u32>("component_data[1]", 12),
+        };
+
         constant<u8, 5> packet_id;
         constant<u8, 16> packet_size;
         u16 component_id = 0;
@@ -59,11 +59,41 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const short_symbol_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, short_symbol_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 23> fields = {
+            describe<constant<u8, 35>>("packet_id", 0),
+            describe<constant<u8, 16>>("packet_size", 1),
+            describe<u16>("symbol_id", 2),
+            describe_bits<symbol_control::symbol_state_t>("symbol_state", 4, 0, 2),
+            describe_bits<attach_t>("attach_state", 4, 2, 1),
+            describe_bits<symbol_control::flash_control_t>("flash_control", 4, 3, 1),
+            describe_bits<inherit_t>("inherit_color", 4, 4, 1),
+            describe_bits<u8>("reserved_0", 4, 5, 3),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<attribute_select_t>("attribute_select[0]", 6),
+            describe<attribute_select_t>("attribute_select[1]", 7),
+            describe<u32>("attribute_values[0].integer", 8),
+            describe_alias<f32>("attribute_values[0].floating", 8),
+            describe_alias<u8>("attribute_values[0].red", 8),
+            describe_alias<u8>("attribute_values[0].blue", 9),
+            describe_alias<u8>("attribute_values[0].green", 10),
+            describe_alias<u8>("attribute_values[0].alpha", 11),
+            describe<u32>("attribute_values[1].integer", 12),
+            describe_alias<f32>("attribute_values[1].floating", 12),
+            describe_alias<u8>("attribute_values[1].red", 12),
+            describe_alias<u8>("attribute_values[1].blue", 13),
+            describe_alias<u8>("attribute_values[1].green", 14),
+            describe_alias<u8>("attribute_values[1].alpha", 15),
+        };
+
         constant<u8, 35> packet_id;
         constant<u8, 16> packet_size;
         u16 symbol_id = 0;
@@ -5,7 +5,7 @@
 namespace cigi
 {
     // VERSION 3.3, see CIGI ICD v3.3  4.1.31
-    struct symbol_circle_definition
+    struct alignas(std::uint64_t) symbol_circle_definition
     {
         enum class drawing_style_t : u8
         {
@@ -26,22 +26,27 @@ namespace cigi
         symbol_circle_definition(const symbol_circle_definition&) = default;
         symbol_circle_definition(symbol_circle_definition&&) noexcept = default;
         ~symbol_circle_definition() = default;
-        auto operator =(const symbol_circle_definition& other) -> symbol_circle_definition&
-        {
-            symbol_id = other.symbol_id;
-            drawing_style = other.drawing_style;
-            stipple_pattern = other.stipple_pattern;
-            line_width = other.line_width;
-            stipple_pattern_length = other.stipple_pattern_length;
-            arcs = other.arcs;
-            packet_size = other.packet_size;
-
-            return *this;
-        };
+        auto operator =(const symbol_circle_definition&) -> symbol_circle_definition& = default;
 
         static auto serialize(const symbol_circle_definition& data) -> serialize_result
         {
             serialized_data out{ data.packet_size };
+            auto [size, errors] = serialize_into(data, out.data);
+            return std::make_pair(out, errors);
+        };
+        static auto serialize_into(const symbol_circle_definition& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            // the payload must agree with packet_size, or we'd write past it.
+            if (16 + 24 * data.arcs.size() != data.packet_size.value)
+            {
+                return std::make_pair(std::size_t{ 0 }, serialized_data::errors::mismatched_constant);
+            }
+            if (buffer.size() < data.packet_size.value)
+            {
+                return std::make_pair(std::size_t{ 0 }, serialized_data::errors::insufficient_buffer);
+            }
+
+            serialized_span out{ buffer };
 
             out << data.packet_id
                 << data.packet_size
@@ -64,8 +69,7 @@ namespace cigi
                     << arc.end_angle;
             }
 
-            out.p.base = out.data.data();
-            return std::make_pair(out, serialized_data::errors::none);
+            return std::make_pair(out.size(), serialized_data::errors::none);
         };
         static auto deserialize(serialized_data& data, symbol_circle_definition& packet) -> serialized_data::errors
         {
@@ -118,6 +122,26 @@ namespace cigi
             return serialized_data::errors::none;
         };
 
+        static constexpr std::array<field_descriptor, 9> fields = {
+            describe<constant<u8, 31>>("packet_id", 0),
+            describe<bounded<u8, 16, 232>>("packet_size", 1),
+            describe<u16>("symbol_id", 2),
+            describe_bits<drawing_style_t>("drawing_style", 4, 0, 1),
+            describe_bits<u8>("reserved_0", 4, 1, 7),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<u16>("stipple_pattern", 6),
+            describe<f32>("line_width", 8),
+            describe<f32>("stipple_pattern_length", 12),
+        };
+        static constexpr std::array<field_descriptor, 6> element_fields = {
+            describe<f32>("center_u", 0),
+            describe<f32>("center_v", 4),
+            describe<bounded<f32, 0.f>>("radius", 8),
+            describe<bounded<f32, 0.f>>("inner_radius", 12),
+            describe<bounded<f32, 0.f, 360.f>>("start_angle", 16),
+            describe<bounded<f32, 0.f, 360.f>>("end_angle", 20),
+        };
+
         constant<u8, 31> packet_id;
         bounded<u8, 16, 232> packet_size = 16;
         u16 symbol_id = 0;
@@ -129,7 +153,7 @@ namespace cigi
         u16 stipple_pattern = 0;
         f32 line_width = 0.f;
         f32 stipple_pattern_length = 0.f;
-        std::vector<arc_t> arcs = {};
+        inline_vector<arc_t, 9> arcs = {};
 
         // fails if there are already 9 arcs, the maximum allowed in 1 packet.
         auto add_arc(const arc_t& arc) -> bool
@@ -30,11 +30,25 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const symbol_clone& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, symbol_clone& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 7> fields = {
+            describe<constant<u8, 33>>("packet_id", 0),
+            describe<constant<u8, 8>>("packet_size", 1),
+            describe<u16>("symbol_id", 2),
+            describe_bits<source_type_t>("source_type", 4, 0, 1),
+            describe_bits<u8>("reserved_0", 4, 1, 7),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<u16>("source_id", 6),
+        };
+
         constant<u8, 33> packet_id;
         constant<u8, 8> packet_size;
         u16 symbol_id = 0;
@@ -52,11 +52,41 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const symbol_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, symbol_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 23> fields = {
+            describe<constant<u8, 34>>("packet_id", 0),
+            describe<constant<u8, 40>>("packet_size", 1),
+            describe<u16>("symbol_id", 2),
+            describe_bits<symbol_state_t>("symbol_state", 4, 0, 2),
+            describe_bits<attach_t>("attach_state", 4, 2, 1),
+            describe_bits<flash_control_t>("flash_control", 4, 3, 1),
+            describe_bits<inherit_t>("inherit_color", 4, 4, 1),
+            describe_bits<u8>("reserved_0", 4, 5, 3),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<u16>("parent_symbol_id", 6),
+            describe<u16>("surface_id", 8),
+            describe<u8>("layer", 10),
+            describe<bounded<u8, 0, 100>>("flash_duty_cycle_percentage", 11),
+            describe<f32>("flash_period", 12),
+            describe<f32>("position_u", 16),
+            describe<f32>("position_v", 20),
+            describe<bounded<f32, 0.f, 360.f>>("rotation", 24),
+            describe<u8>("red", 28),
+            describe<u8>("green", 29),
+            describe<u8>("blue", 30),
+            describe<u8>("alpha", 31),
+            describe<bounded<f32, 0.f>>("scale_u", 32),
+            describe<bounded<f32, 0.f>>("scale_v", 36),
+        };
+
         constant<u8, 34> packet_id;
         constant<u8, 40> packet_size;
         u16 symbol_id = 0;
@@ -5,7 +5,7 @@
 namespace cigi
 {
     // VERSION 3.3, see CIGI ICD v3.3  4.1.32
-    struct symbol_line_definition
+    struct alignas(std::uint64_t) symbol_line_definition
     {
         enum class primitive_type_t
         {
@@ -27,22 +27,27 @@ namespace cigi
         symbol_line_definition(const symbol_line_definition&) = default;
         symbol_line_definition(symbol_line_definition&&) noexcept = default;
         ~symbol_line_definition() = default;
-        auto operator =(const symbol_line_definition& other) -> symbol_line_definition&
-        {
-            symbol_id = other.symbol_id;
-            primitive_type = other.primitive_type;
-            stipple_pattern = other.stipple_pattern;
-            line_width = other.line_width;
-            stipple_pattern_length = other.stipple_pattern_length;
-            vertices = other.vertices;
-            packet_size = other.packet_size;
-
-            return *this;
-        };
+        auto operator =(const symbol_line_definition&) -> symbol_line_definition& = default;
 
         static auto serialize(const symbol_line_definition& data) -> serialize_result
         {
             serialized_data out{ data.packet_size };
+            auto [size, errors] = serialize_into(data, out.data);
+            return std::make_pair(out, errors);
+        };
+        static auto serialize_into(const symbol_line_definition& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            // the payload must agree with packet_size, or we'd write past it.
+            if (16 + 8 * data.vertices.size() != data.packet_size.value)
+            {
+                return std::make_pair(std::size_t{ 0 }, serialized_data::errors::mismatched_constant);
+            }
+            if (buffer.size() < data.packet_size.value)
+            {
+                return std::make_pair(std::size_t{ 0 }, serialized_data::errors::insufficient_buffer);
+            }
+
+            serialized_span out{ buffer };
 
             out << data.packet_id
                 << data.packet_size
@@ -61,8 +66,7 @@ namespace cigi
                     << vertex.v;
             }
 
-            out.p.base = out.data.data();
-            return std::make_pair(out, serialized_data::errors::none);
+            return std::make_pair(out.size(), serialized_data::errors::none);
         };
         static auto deserialize(serialized_data& data, symbol_line_definition& packet) -> serialized_data::errors
         {
@@ -111,6 +115,22 @@ namespace cigi
             return serialized_data::errors::none;
         };
 
+        static constexpr std::array<field_descriptor, 9> fields = {
+            describe<constant<u8, 32>>("packet_id", 0),
+            describe<bounded<u8, 16, 248>>("packet_size", 1),
+            describe<u16>("symbol_id", 2),
+            describe_bits<primitive_type_t>("primitive_type", 4, 0, 4),
+            describe_bits<u8>("reserved_0", 4, 4, 4),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<u16>("stipple_pattern", 6),
+            describe<f32>("line_width", 8),
+            describe<f32>("stipple_pattern_length", 12),
+        };
+        static constexpr std::array<field_descriptor, 2> element_fields = {
+            describe<f32>("u", 0),
+            describe<f32>("v", 4),
+        };
+
         constant<u8, 32> packet_id;
         bounded<u8, 16, 248> packet_size = 16;
         u16 symbol_id = 0;
@@ -122,7 +142,7 @@ namespace cigi
         u16 stipple_pattern = 0;
         f32 line_width = 0;
         f32 stipple_pattern_length = 0;
-        std::vector<vertex_t> vertices = {};
+        inline_vector<vertex_t, 29> vertices = {};
         
         // fails if there are already 29 vertices, the maximum allowed in 1 packet.
         auto add_vertex(const vertex_t& vertex) -> bool
@@ -55,11 +55,45 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const symbol_surface_definition& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, symbol_surface_definition& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 27> fields = {
+            describe<constant<u8, 29>>("packet_id", 0),
+            describe<constant<u8, 56>>("packet_size", 1),
+            describe<u16>("surface_id", 2),
+            describe_bits<state_t>("surface_state", 4, 0, 1),
+            describe_bits<attach_t>("attach_type", 4, 1, 1),
+            describe_bits<billboard_t>("billboard", 4, 2, 1),
+            describe_bits<enable_t>("perspective_growth_enable", 4, 3, 1),
+            describe_bits<u8>("reserved_0", 4, 4, 3),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<u16>("entity_id", 6),
+            describe_alias<u16>("view_id", 6),
+            describe<f32>("x_offset", 8),
+            describe_alias<f32>("left", 8),
+            describe<f32>("y_offset", 12),
+            describe_alias<f32>("right", 12),
+            describe<f32>("z_offset", 16),
+            describe_alias<f32>("top", 16),
+            describe_selected<bounded<f32, 0.f, 360.f>>("yaw", 20, 4, 1, 1, 0),
+            describe_alias<f32>("bottom", 20),
+            describe<bounded<f32, -90.f, 90.f>>("pitch", 24),
+            describe<bounded<f32, -180.f, 180.f>>("roll", 28),
+            describe<bounded<f32, 0.f>>("width", 32),
+            describe<bounded<f32, 0.f>>("height", 36),
+            describe<f32>("min_u", 40),
+            describe<f32>("max_u", 44),
+            describe<f32>("min_v", 48),
+            describe<f32>("max_v", 52),
+        };
+
         constant<u8, 29> packet_id;
         constant<u8, 56> packet_size;
         u16 surface_id = 0;
@@ -5,7 +5,7 @@
 namespace cigi
 {
     // VERSION 3.3, see CIGI ICD v3.3  4.1.30
-    struct symbol_text_definition
+    struct alignas(std::uint64_t) symbol_text_definition
     {
         enum class alignment_t : u8
         {
@@ -51,22 +51,27 @@ namespace cigi
         symbol_text_definition(const symbol_text_definition&) = default;
         symbol_text_definition(symbol_text_definition&&) noexcept = default;
         ~symbol_text_definition() = default;
-        auto operator =(const symbol_text_definition& other) -> symbol_text_definition&
-        {
-            symbol_id = other.symbol_id;
-            alignment = other.alignment;
-            orientation = other.orientation;
-            font_id = other.font_id;
-            font_size = other.font_size;
-            octets = other.octets;
-            packet_size = other.packet_size;
-
-            return *this;
-        };
+        auto operator =(const symbol_text_definition&) -> symbol_text_definition& = default;
 
         static auto serialize(const symbol_text_definition& data) -> serialize_result
         {
             serialized_data out{ data.packet_size };
+            auto [size, errors] = serialize_into(data, out.data);
+            return std::make_pair(out, errors);
+        };
+        static auto serialize_into(const symbol_text_definition& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            // the payload must agree with packet_size, or we'd write past it.
+            if (12 + data.octets.size() != data.packet_size.value)
+            {
+                return std::make_pair(std::size_t{ 0 }, serialized_data::errors::mismatched_constant);
+            }
+            if (buffer.size() < data.packet_size.value)
+            {
+                return std::make_pair(std::size_t{ 0 }, serialized_data::errors::insufficient_buffer);
+            }
+
+            serialized_span out{ buffer };
 
             out << data.packet_id
                 << data.packet_size
@@ -84,8 +89,7 @@ namespace cigi
                 out << octet;
             }
 
-            out.p.base = out.data.data();
-            return std::make_pair(out, serialized_data::errors::none);
+            return std::make_pair(out.size(), serialized_data::errors::none);
         };
         static auto deserialize(serialized_data& data, symbol_text_definition& packet) -> serialized_data::errors
         {
@@ -133,6 +137,21 @@ namespace cigi
             return serialized_data::errors::none;
         };
 
+        static constexpr std::array<field_descriptor, 9> fields = {
+            describe<constant<u8, 30>>("packet_id", 0),
+            describe<bounded<u8, 16, 248>>("packet_size", 1),
+            describe<u16>("symbol_id", 2),
+            describe_bits<alignment_t>("alignment", 4, 0, 4),
+            describe_bits<orientation_t>("orientation", 4, 4, 2),
+            describe_bits<u8>("reserved_0", 4, 6, 2),
+            describe<font_t>("font_id", 5),
+            describe<constant<u16, 0>>("reserved_1", 6),
+            describe<f32>("font_size", 8),
+        };
+        static constexpr std::array<field_descriptor, 1> element_fields = {
+            describe<octet>("octet", 0),
+        };
+
         constant<u8, 30> packet_id;
         bounded<u8, 16, 248> packet_size = 16;
         u16 symbol_id = 0;
@@ -146,7 +165,7 @@ namespace cigi
         constant<u16, 0> reserved_1;
     public:
         f32 font_size = 0.f;
-        std::vector<octet> octets = { 0, 0, 0, 0 };
+        inline_vector<octet, 236> octets = { 0, 0, 0, 0 };
 
         // fails if text would be cut off (text.size() > 235).
         auto set_text(std::string_view text) -> bool
@@ -27,11 +27,27 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const terrestrial_surface_conditions_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, terrestrial_surface_conditions_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 9> fields = {
+            describe<constant<u8, 15>>("packet_id", 0),
+            describe<constant<u8, 8>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe_alias<u16>("region_id", 2),
+            describe<u16>("surface_condition_id", 4),
+            describe_bits<enable_t>("surface_condition_enable", 6, 0, 1),
+            describe_bits<scope_t>("scope", 6, 1, 2),
+            describe_bits<u8>("severity", 6, 3, 5),
+            describe<bounded<u8, 0, 100>>("coverage", 7),
+        };
+
         constant<u8, 15> packet_id;
         constant<u8, 8> packet_size;
         union
@@ -27,11 +27,26 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const trajectory_definition& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, trajectory_definition& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 8> fields = {
+            describe<constant<u8, 20>>("packet_id", 0),
+            describe<constant<u8, 24>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe<f32>("acceleration_x", 4),
+            describe<f32>("acceleration_y", 8),
+            describe<f32>("acceleration_z", 12),
+            describe<f32>("retardation_rate", 16),
+            describe<f32>("terminal_velocity", 20),
+        };
+
         constant<u8, 20> packet_id;
         constant<u8, 24> packet_size;
         u16 entity_id = 0;
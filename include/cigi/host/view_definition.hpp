@@ -65,11 +65,40 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const view_definition& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, view_definition& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 22> fields = {
+            describe<constant<u8, 21>>("packet_id", 0),
+            describe<constant<u8, 32>>("packet_size", 1),
+            describe<u16>("view_id", 2),
+            describe<u8>("group_id", 4),
+            describe_bits<enable_t>("near_enable", 5, 0, 1),
+            describe_bits<enable_t>("far_enable", 5, 1, 1),
+            describe_bits<enable_t>("left_enable", 5, 2, 1),
+            describe_bits<enable_t>("right_enable", 5, 3, 1),
+            describe_bits<enable_t>("top_enable", 5, 4, 1),
+            describe_bits<enable_t>("bottom_enable", 5, 5, 1),
+            describe_bits<mirror_mode_t>("mirror_mode", 5, 6, 2),
+            describe_bits<pixel_replication_mode_t>("pixel_replication_mode", 6, 0, 3),
+            describe_bits<projection_type_t>("projection_type", 6, 3, 1),
+            describe_bits<reorder_t>("reorder", 6, 4, 1),
+            describe_bits<u8>("view_type", 6, 5, 3),
+            describe<constant<u8, 0>>("reserved_0", 7),
+            describe<bounded<f32, 0.f>>("near", 8),
+            describe<bounded<f32, 0.f>>("far", 12),
+            describe<bounded<f32, -90.f, 90.f>>("left", 16),
+            describe<bounded<f32, -90.f, 90.f>>("right", 20),
+            describe<bounded<f32, -90.f, 90.f>>("top", 24),
+            describe<bounded<f32, -90.f, 90.f>>("bottom", 28),
+        };
+
         constant<u8, 21> packet_id;
         constant<u8, 32> packet_size;
         u16 view_id = 0;
@@ -29,11 +29,34 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const wave_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, wave_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 16> fields = {
+            describe<constant<u8, 14>>("packet_id", 0),
+            describe<constant<u8, 32>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe_alias<u16>("region_id", 2),
+            describe<u8>("wave_id", 4),
+            describe_bits<enable_t>("wave_enable", 5, 0, 1),
+            describe_bits<scope_t>("scope", 5, 1, 2),
+            describe_bits<breaker_type_t>("breaker_type", 5, 3, 2),
+            describe_bits<u8>("reserved_0", 5, 5, 3),
+            describe<constant<u16, 0>>("reserved_1", 6),
+            describe<bounded<f32, 0.f>>("wave_height", 8),
+            describe<bounded<f32, 0.f>>("wavelength", 12),
+            describe<bounded<f32, 0.f>>("period", 16),
+            describe<bounded<f32, 0.f, 360.f>>("direction", 20),
+            describe<bounded<f32, -360.f, 360.f>>("phase_offset", 24),
+            describe<bounded<f32, -180.f, 180.f>>("leading", 28),
+        };
+
         constant<u8, 14> packet_id;
         constant<u8, 32> packet_size;
         union
@@ -76,11 +76,44 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const weather_control& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, weather_control& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 26> fields = {
+            describe<constant<u8, 12>>("packet_id", 0),
+            describe<constant<u8, 56>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe_alias<u16>("region_id", 2),
+            describe<layer_t>("layer_id", 4),
+            describe<bounded<u8, 0, 100>>("humidity", 5),
+            describe_bits<enable_t>("weather_enable", 6, 0, 1),
+            describe_bits<enable_t>("scud_enable", 6, 1, 1),
+            describe_bits<enable_t>("random_winds_enable", 6, 2, 1),
+            describe_bits<enable_t>("random_lightning_enable", 6, 3, 1),
+            describe_bits<cloud_type_t>("cloud_type", 6, 4, 4),
+            describe_bits<scope_t>("scope", 7, 0, 2),
+            describe_bits<u8>("severity", 7, 2, 3),
+            describe_bits<u8>("reserved_0", 7, 5, 3),
+            describe<f32>("air_temperature", 8),
+            describe<f32>("visibility_range", 12),
+            describe<bounded<f32, 0.f, 100.f>>("scud_frequency", 16),
+            describe<bounded<f32, 0.f, 100.f>>("coverage", 20),
+            describe<f32>("base_elevation", 24),
+            describe<f32>("thickness", 28),
+            describe<f32>("transition_band", 32),
+            describe<bounded<f32, 0.f>>("horizontal_wind_speed", 36),
+            describe<f32>("vertical_wind_speed", 40),
+            describe<bounded<f32, 0.f, 360.f>>("wind_direction", 44),
+            describe<bounded<f32, 0.f>>("barometric_pressure", 48),
+            describe<bounded<f32, 0.f>>("aerosol_concentration", 52),
+        };
+
         constant<u8, 12> packet_id;
         constant<u8, 56> packet_size;
         union
@@ -24,11 +24,23 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const aerosol_concentration_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, aerosol_concentration_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 5> fields = {
+            describe<constant<u8, 110>>("packet_id", 0),
+            describe<constant<u8, 8>>("packet_size", 1),
+            describe<u8>("request_id", 2),
+            describe<u8>("layer_id", 3),
+            describe<bounded<f32, 0.f>>("aerosol_concentration", 4),
+        };
+
         constant<u8, 110> packet_id;
         constant<u8, 8> packet_size;
         u8 request_id = 0;
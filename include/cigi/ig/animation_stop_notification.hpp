@@ -22,11 +22,22 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const animation_stop_notification& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, animation_stop_notification& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 4> fields = {
+            describe<constant<u8, 115>>("packet_id", 0),
+            describe<constant<u8, 8>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe<constant<u32, 0>>("reserved_0", 4),
+        };
+
         constant<u8, 115> packet_id;
         constant<u8, 8> packet_size;
         u16 entity_id = 0;
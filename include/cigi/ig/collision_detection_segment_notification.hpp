@@ -27,11 +27,27 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const collision_detection_segment_notification& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, collision_detection_segment_notification& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 9> fields = {
+            describe<constant<u8, 113>>("packet_id", 0),
+            describe<constant<u8, 16>>("packet_size", 1),
+            describe<u16>("entity_id", 2),
+            describe<u8>("segment_id", 4),
+            describe_bits<collision_t>("collision_type", 5, 0, 1),
+            describe_bits<u8>("reserved_0", 5, 1, 7),
+            describe<u16>("contacted_entity_id", 6),
+            describe<u32>("material_code", 8),
+            describe<f32>("intersection_distance", 12),
+        };
+
         constant<u8, 113> packet_id;
         constant<u8, 16> packet_size;
         u16 entity_id = 0;
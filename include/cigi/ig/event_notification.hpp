@@ -26,11 +26,24 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const event_notification& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, event_notification& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 6> fields = {
+            describe<constant<u8, 116>>("packet_id", 0),
+            describe<constant<u8, 16>>("packet_size", 1),
+            describe<u16>("event_id", 2),
+            describe<u32>("event_data[0]", 4),
+            describe<u32>("event_data[1]", 8),
+            describe<u32>("event_data[2]", 12),
+        };
+
         constant<u8, 116> packet_id;
         constant<u8, 16> packet_size;
         u16 event_id = 0;
@@ -29,11 +29,32 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const hat_hot_extended_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, hat_hot_extended_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 14> fields = {
+            describe<constant<u8, 103>>("packet_id", 0),
+            describe<constant<u8, 40>>("packet_size", 1),
+            describe<u16>("hat_hot_id", 2),
+            describe_bits<valid_t>("valid", 4, 0, 1),
+            describe_bits<u8>("reserved_0", 4, 1, 3),
+            describe_bits<u8>("host_frame_number_lsn", 4, 4, 4),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<constant<u16, 0>>("reserved_2", 6),
+            describe<f64>("hat", 8),
+            describe<f64>("hot", 16),
+            describe<u32>("material_code", 24),
+            describe<bounded<f32, -180.f, 180.f>>("normal_vector_azimuth", 28),
+            describe<bounded<f32, -90.f, 90.f>>("normal_vector_elevation", 32),
+            describe<constant<u32, 0>>("reserved_3", 36),
+        };
+
         constant<u8, 103> packet_id;
         constant<u8, 40> packet_size;
         u16 hat_hot_id = 0;
@@ -32,11 +32,28 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const hat_hot_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, hat_hot_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 10> fields = {
+            describe<constant<u8, 102>>("packet_id", 0),
+            describe<constant<u8, 16>>("packet_size", 1),
+            describe<u16>("hat_hot_id", 2),
+            describe_bits<valid_t>("valid", 4, 0, 1),
+            describe_bits<response_type_t>("response_type", 4, 1, 1),
+            describe_bits<u8>("reserved_0", 4, 2, 2),
+            describe_bits<u8>("host_frame_number_lsn", 4, 4, 4),
+            describe<constant<u8, 0>>("reserved_1", 5),
+            describe<constant<u16, 0>>("reserved_2", 6),
+            describe<f64>("height", 8),
+        };
+
         constant<u8, 102> packet_id;
         constant<u8, 16> packet_size;
         u16 hat_hot_id = 0;
@@ -11,18 +11,27 @@ namespace cigi
         image_generator_message(const image_generator_message&) = default;
         image_generator_message(image_generator_message&&) noexcept = default;
         ~image_generator_message() = default;
-        auto operator =(const image_generator_message& other) -> image_generator_message&
-        {
-            message_id = other.message_id;
-            octets = other.octets;
-            packet_size = other.packet_size;
-
-            return *this;
-        };
+        auto operator =(const image_generator_message&) -> image_generator_message& = default;
 
         static auto serialize(const image_generator_message& data) -> serialize_result
         {
             serialized_data out{ data.packet_size };
+            auto [size, errors] = serialize_into(data, out.data);
+            return std::make_pair(out, errors);
+        };
+        static auto serialize_into(const image_generator_message& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            // the payload must agree with packet_size, or we'd write past it.
+            if (4 + data.octets.size() != data.packet_size.value)
+            {
+                return std::make_pair(std::size_t{ 0 }, serialized_data::errors::mismatched_constant);
+            }
+            if (buffer.size() < data.packet_size.value)
+            {
+                return std::make_pair(std::size_t{ 0 }, serialized_data::errors::insufficient_buffer);
+            }
+
+            serialized_span out{ buffer };
 
             out << data.packet_id
                 << data.packet_size
@@ -32,8 +41,7 @@ namespace cigi
                 out << octet;
             }
 
-            out.p.base = out.data.data();
-            return std::make_pair(out, serialized_data::errors::none);
+            return std::make_pair(out.size(), serialized_data::errors::none);
         };
         static auto deserialize(serialized_data& data, image_generator_message& packet) -> serialized_data::errors
         {
@@ -58,10 +66,19 @@ namespace cigi
             return serialized_data::errors::none;
         };
 
+        static constexpr std::array<field_descriptor, 3> fields = {
+            describe<constant<u8, 117>>("packet_id", 0),
+            describe<bounded<u8, 8, 104>>("packet_size", 1),
+            describe<u16>("message_id", 2),
+        };
+        static constexpr std::array<field_descriptor, 1> element_fields = {
+            describe<octet>("octet", 0),
+        };
+
         constant<u8, 117> packet_id;
         bounded<u8, 8, 104> packet_size = 8;
         u16 message_id = 0;
-        std::vector<octet> octets = { 0, 0, 0, 0 };
+        inline_vector<octet, 100> octets = { 0, 0, 0, 0 };
 
         // see symbol_text_definition::set_text for in-depth explanation.
         auto set_message(std::string_view message) -> bool
@@ -43,11 +43,42 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const line_of_sight_extended_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, line_of_sight_extended_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 24> fields = {
+            describe<constant<u8, 105>>("packet_id", 0),
+            describe<constant<u8, 56>>("packet_size", 1),
+            describe<u16>("los_id", 2),
+            describe_bits<valid_t>("valid", 4, 0, 1),
+            describe_bits<valid_t>("entity_id_valid", 4, 1, 1),
+            describe_bits<valid_t>("range_valid", 4, 2, 1),
+            describe_bits<visible_t>("visible", 4, 3, 1),
+            describe_bits<u8>("host_frame_number_lsn", 4, 4, 4),
+            describe<u8>("response_count", 5),
+            describe<u16>("entity_id", 6),
+            describe<f64>("range", 8),
+            describe<f64>("x_offset", 16),
+            describe_alias<bounded<f64, -90.0, 90.0>>("latitude", 16),
+            describe<f64>("y_offset", 24),
+            describe_alias<bounded<f64, -180.0, 180.0>>("longitude", 24),
+            describe<f64>("z_offset", 32),
+            describe_alias<f64>("altitude", 32),
+            describe<u8>("red", 40),
+            describe<u8>("green", 41),
+            describe<u8>("blue", 42),
+            describe<u8>("alpha", 43),
+            describe<u32>("material_code", 44),
+            describe<bounded<f32, -180.f, 180.f>>("normal_vector_azimuth", 48),
+            describe<bounded<f32, -90.f, 90.f>>("normal_vector_elevation", 52),
+        };
+
         constant<u8, 105> packet_id;
         constant<u8, 56> packet_size;
         u16 los_id = 0;
@@ -35,11 +35,29 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const line_of_sight_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, line_of_sight_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 11> fields = {
+            describe<constant<u8, 104>>("packet_id", 0),
+            describe<constant<u8, 16>>("packet_size", 1),
+            describe<u16>("los_id", 2),
+            describe_bits<valid_t>("valid", 4, 0, 1),
+            describe_bits<valid_t>("entity_id_valid", 4, 1, 1),
+            describe_bits<visible_t>("visible", 4, 2, 1),
+            describe_bits<u8>("reserved_0", 4, 3, 1),
+            describe_bits<u8>("host_frame_number_lsn", 4, 4, 4),
+            describe<u8>("response_count", 5),
+            describe<u16>("entity_id", 6),
+            describe<f64>("range", 8),
+        };
+
         constant<u8, 104> packet_id;
         constant<u8, 16> packet_size;
         u16 los_id = 0;
@@ -25,11 +25,25 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const maritime_surface_conditions_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, maritime_surface_conditions_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 7> fields = {
+            describe<constant<u8, 111>>("packet_id", 0),
+            describe<constant<u8, 16>>("packet_size", 1),
+            describe<u8>("request_id", 2),
+            describe<constant<u8, 0>>("reserved_0", 3),
+            describe<f32>("sea_surface_height", 4),
+            describe<f32>("surface_water_temperature", 8),
+            describe<bounded<f32, 0.f, 100.f>>("surface_clarity", 12),
+        };
+
         constant<u8, 111> packet_id;
         constant<u8, 16> packet_size;
         u8 request_id = 0;
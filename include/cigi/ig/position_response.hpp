@@ -35,11 +35,36 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const position_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, position_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 18> fields = {
+            describe<constant<u8, 108>>("packet_id", 0),
+            describe<constant<u8, 48>>("packet_size", 1),
+            describe<u16>("object_id", 2),
+            describe<u8>("articulated_part_id", 4),
+            describe_bits<object_class_t>("object_class", 5, 0, 3),
+            describe_bits<coordinate_system_t>("coordinate_system", 5, 3, 2),
+            describe_bits<u8>("reserved_0", 5, 5, 3),
+            describe<constant<u16, 0>>("reserved_1", 6),
+            describe<f64>("x_offset", 8),
+            describe_alias<bounded<f64, -90.0, 90.0>>("latitude", 8),
+            describe<f64>("y_offset", 16),
+            describe_alias<bounded<f64, -180.0, 180.0>>("longitude", 16),
+            describe<f64>("z_offset", 24),
+            describe_alias<f64>("altitude", 24),
+            describe<bounded<f32, -180.f, 180.f>>("roll", 32),
+            describe<bounded<f32, -90.f, 90.f>>("pitch", 36),
+            describe<bounded<f32, 0.f, 360.f>>("yaw", 40),
+            describe<constant<u32, 0>>("reserved_2", 44),
+        };
+
         constant<u8, 108> packet_id;
         constant<u8, 48> packet_size;
         u16 object_id = 0;
@@ -37,11 +37,34 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const sensor_extended_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, sensor_extended_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 16> fields = {
+            describe<constant<u8, 107>>("packet_id", 0),
+            describe<constant<u8, 48>>("packet_size", 1),
+            describe<u16>("view_id", 2),
+            describe<u8>("sensor_id", 4),
+            describe_bits<sensor_status_t>("sensor_status", 5, 0, 2),
+            describe_bits<valid_t>("entity_id_valid", 5, 2, 1),
+            describe_bits<u8>("reserved_0", 5, 3, 5),
+            describe<u16>("entity_id", 6),
+            describe<u16>("gate_x_size", 8),
+            describe<u16>("gate_y_size", 10),
+            describe<f32>("gate_x_offset", 12),
+            describe<f32>("gate_y_offset", 16),
+            describe<u32>("host_frame_number", 20),
+            describe<bounded<f64, -90.0, 90.0>>("track_point_latitude", 24),
+            describe<bounded<f64, -180.0, 180.0>>("track_point_longitude", 32),
+            describe<f64>("track_point_altitude", 40),
+        };
+
         constant<u8, 107> packet_id;
         constant<u8, 48> packet_size;
         u16 view_id = 0;
@@ -37,11 +37,30 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const sensor_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, sensor_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 12> fields = {
+            describe<constant<u8, 106>>("packet_id", 0),
+            describe<constant<u8, 24>>("packet_size", 1),
+            describe<u16>("view_id", 2),
+            describe<u8>("sensor_id", 4),
+            describe_bits<sensor_status_t>("sensor_status", 5, 0, 2),
+            describe_bits<u8>("reserved_0", 5, 2, 6),
+            describe<constant<u16, 0>>("reserved_1", 6),
+            describe<u16>("gate_x_size", 8),
+            describe<u16>("gate_y_size", 10),
+            describe<f32>("gate_x_position", 12),
+            describe<f32>("gate_y_position", 16),
+            describe<u32>("host_frame_number", 20),
+        };
+
         constant<u8, 106> packet_id;
         constant<u8, 24> packet_size;
         u16 view_id = 0;
@@ -44,11 +44,32 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const start_of_frame& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, start_of_frame& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 14> fields = {
+            describe<constant<u8, 101>>("packet_id", 0),
+            describe<constant<u8, 24>>("packet_size", 1),
+            describe<constant<u8, 3>>("major_version", 2),
+            describe<s8>("database_number", 3),
+            describe<u8>("ig_status_code", 4),
+            describe_bits<ig_mode_t>("ig_mode", 5, 0, 2),
+            describe_bits<valid_t>("timestamp_valid", 5, 2, 1),
+            describe_bits<earth_reference_model_t>("earth_reference_model", 5, 3, 1),
+            describe_bits<u8>("minor_version", 5, 4, 4),
+            describe<u16>("byte_swap_magic_number", 6),
+            describe<u32>("ig_frame_number", 8),
+            describe<u32>("timestamp", 12),
+            describe<u32>("last_host_frame_number", 16),
+            describe<constant<u32, 0>>("reserved_0", 20),
+        };
+
         constant<u8, 101> packet_id;
         constant<u8, 24> packet_size;
         constant<u8, 3> major_version;
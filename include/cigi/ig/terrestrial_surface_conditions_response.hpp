@@ -23,11 +23,23 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const terrestrial_surface_conditions_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, terrestrial_surface_conditions_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 5> fields = {
+            describe<constant<u8, 112>>("packet_id", 0),
+            describe<constant<u8, 8>>("packet_size", 1),
+            describe<u8>("request_id", 2),
+            describe<constant<u8, 0>>("reserved_0", 3),
+            describe<bounded<u32, 0, 65'535>>("surface_condition_id", 4),
+        };
+
         constant<u8, 112> packet_id;
         constant<u8, 8> packet_size;
         u8 request_id = 0;
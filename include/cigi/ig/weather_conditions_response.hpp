@@ -29,11 +29,29 @@ namespace cigi
         {
             return default_serialize(data);
         };
+        static auto serialize_into(const weather_conditions_response& data, std::span<std::byte> buffer) -> serialize_into_result
+        {
+            return default_serialize_into(data, buffer);
+        };
         static auto deserialize(serialized_data& data, weather_conditions_response& packet) -> serialized_data::errors
         {
             return default_deserialize(data, packet);
         };
 
+        static constexpr std::array<field_descriptor, 11> fields = {
+            describe<constant<u8, 109>>("packet_id", 0),
+            describe<constant<u8, 32>>("packet_size", 1),
+            describe<u8>("request_id", 2),
+            describe<bounded<u8, 0, 100>>("humidity", 3),
+            describe<f32>("air_temperature", 4),
+            describe<bounded<f32, 0.f>>("visibility_range", 8),
+            describe<bounded<f32, 0.f>>("horizontal_wind_speed", 12),
+            describe<f32>("vertical_wind_speed", 16),
+            describe<bounded<f32, 0.f, 360.f>>("wind_direction", 20),
+            describe<bounded<f32, 0.f>>("barometric_pressure", 24),
+            describe<constant<u32, 0>>("reserved_0", 28),
+        };
+
         constant<u8, 109> packet_id;
         constant<u8, 32> packet_size;
         u8 request_id = 0;
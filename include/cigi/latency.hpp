@@ -0,0 +1,91 @@
+#pragma once
+
+#include "general.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <limits>
+
+namespace cigi
+{
+    // counts of latencies in power-of-two buckets: bucket i holds [2^i,
+    // 2^(i+1)) nanoseconds, and bucket 0 holds 0 as well. the last bucket
+    // holds everything from about 9 minutes up.
+    struct latency_histogram
+    {
+        static constexpr std::size_t bucket_count = 40;
+
+        // negative latencies, e.g. across a clock step, count as 0.
+        auto record(std::chrono::nanoseconds latency) noexcept -> void
+        {
+            u64 ns = latency.count() > 0 ? u64(latency.count()) : 0;
+            std::size_t bucket = ns == 0 ? 0 : std::min<std::size_t>(std::bit_width(ns) - 1, bucket_count - 1);
+            ++buckets[bucket];
+            ++total;
+            sum += ns;
+            minimum = std::min(minimum, ns);
+            maximum = std::max(maximum, ns);
+        };
+        auto reset() noexcept -> void
+        {
+            *this = {};
+        };
+
+        [[nodiscard]]
+        auto count() const noexcept -> u64
+        {
+            return total;
+        };
+        [[nodiscard]]
+        auto bucket(std::size_t i) const noexcept -> u64
+        {
+            return buckets[i];
+        };
+        [[nodiscard]]
+        auto min() const noexcept -> std::chrono::nanoseconds
+        {
+            return std::chrono::nanoseconds(total == 0 ? 0 : minimum);
+        };
+        [[nodiscard]]
+        auto max() const noexcept -> std::chrono::nanoseconds
+        {
+            return std::chrono::nanoseconds(maximum);
+        };
+        [[nodiscard]]
+        auto mean() const noexcept -> std::chrono::nanoseconds
+        {
+            return std::chrono::nanoseconds(total == 0 ? 0 : sum / total);
+        };
+        // an upper bound on the latency below which fraction (0 to 1) of the
+        // samples fall: the top of the bucket it lands in, at most max.
+        [[nodiscard]]
+        auto percentile(double fraction) const noexcept -> std::chrono::nanoseconds
+        {
+            if (total == 0)
+            {
+                return {};
+            }
+
+            u64 rank = u64(std::clamp(fraction, 0.0, 1.0) * double(total - 1)) + 1;
+            u64 seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i)
+            {
+                seen += buckets[i];
+                if (seen >= rank)
+                {
+                    u64 top = i + 1 < 64 ? (u64(1) << (i + 1)) - 1 : std::numeric_limits<u64>::max();
+                    return std::chrono::nanoseconds(std::min(top, maximum));
+                }
+            }
+            return max();
+        };
+
+    private:
+        std::array<u64, bucket_count> buckets = {};
+        u64 total = 0;
+        u64 sum = 0;
+        u64 minimum = std::numeric_limits<u64>::max();
+        u64 maximum = 0;
+    };
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "transport.hpp"
+#include "datagram_ring.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace cigi
+{
+    // one end of a loopback_link: sends into one ring and receives from the
+    // other, without any syscalls.
+    struct loopback_transport : transport
+    {
+        loopback_transport(datagram_ring& tx, datagram_ring& rx) :
+            tx{ &tx },
+            rx{ &rx }
+        {
+            batch.reserve(rx.capacity());
+        };
+
+        // datagrams are packed up to the ring's slot size; those that don't
+        // fit in the peer's ring are dropped and counted as its overruns.
+        auto send_packets(std::span<const std::span<const std::byte>> packets) -> std::size_t override
+        {
+            std::size_t sent = 0;
+            for_each_datagram(packets, tx->buffer_size(), [&](std::span<const std::span<const std::byte>> group, std::size_t size)
+            {
+                auto buffer = tx->acquire();
+                if (buffer.empty() || size > buffer.size())
+                {
+                    return;
+                }
+
+                std::byte* out = buffer.data();
+                for (const auto& packet : group)
+                {
+                    std::memcpy(out, packet.data(), packet.size());
+                    out += packet.size();
+                }
+                tx->commit(size);
+                ++sent;
+            });
+            return sent;
+        };
+        // sleeps while waiting, until the sender commits a datagram.
+        auto wait(std::chrono::microseconds timeout) -> bool override
+        {
+            return rx->wait(timeout, held);
+        };
+        // read in place; the slots go back to the sender on the next call.
+        auto read_batch() -> std::span<const received_datagram> override
+        {
+            rx->pop(held);
+            held = 0;
+            batch.clear();
+            while (auto datagram = rx->peek(held))
+            {
+                batch.push_back({ .bytes = *datagram });
+                if (++held == rx->capacity())
+                {
+                    break;
+                }
+            }
+            return batch;
+        };
+        [[nodiscard]]
+        auto batch_size() const -> std::size_t override
+        {
+            return rx->capacity();
+        };
+        [[nodiscard]]
+        auto mtu() const -> std::size_t override
+        {
+            return tx->buffer_size();
+        };
+
+    private:
+        datagram_ring* tx;
+        datagram_ring* rx;
+        std::size_t held = 0;
+        std::vector<received_datagram> batch;
+    };
+
+    // an in-process link between a host session and an IG session, through a
+    // pair of lock-free single-producer/single-consumer rings:
+    //
+    //     cigi::loopback_link link;
+    //     host.connect(link.host());
+    //     ig.connect(link.ig());
+    //
+    // no kernel in the way, so tests are deterministic and benchmarks measure
+    // the protocol stack alone. each end may be used from its own thread. the
+    // link must outlive the sessions connected to it.
+    struct loopback_link
+    {
+        explicit loopback_link(std::size_t slots = datagram_ring::default_slots, std::size_t slot_size = datagram_ring::default_slot_size) :
+            to_ig{ slots, slot_size },
+            to_host{ slots, slot_size }
+        {};
+        loopback_link(const loopback_link&) = delete;
+        auto operator =(const loopback_link&) -> loopback_link& = delete;
+
+        [[nodiscard]]
+        auto host() noexcept -> loopback_transport&
+        {
+            return host_end;
+        };
+        [[nodiscard]]
+        auto ig() noexcept -> loopback_transport&
+        {
+            return ig_end;
+        };
+        // datagrams sent to each side that were dropped because its ring was
+        // full, among other counters.
+        [[nodiscard]]
+        auto host_ring() const noexcept -> const datagram_ring&
+        {
+            return to_host;
+        };
+        [[nodiscard]]
+        auto ig_ring() const noexcept -> const datagram_ring&
+        {
+            return to_ig;
+        };
+
+    private:
+        datagram_ring to_ig;
+        datagram_ring to_host;
+        loopback_transport host_end{ to_ig, to_host };
+        loopback_transport ig_end{ to_host, to_ig };
+    };
+};
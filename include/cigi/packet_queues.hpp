@@ -0,0 +1,186 @@
+#pragma once
+
+#include "general.hpp"
+
+#include <vector>
+
+namespace cigi
+{
+    // what a full bounded ring does with one more packet.
+    enum class overflow_policy : u8
+    {
+        // discard the oldest queued packet to make room.
+        drop_oldest = 0,
+        // discard the packet being pushed.
+        drop_newest = 1,
+    };
+
+    // a ring buffer of packets per packet id, O(1) to push and pop. all rings
+    // share one arena of packet slots; a ring takes its slots the first time
+    // its id is pushed, so ids never seen cost nothing.
+    //
+    // like an unbounded queue, a ring left at the default capacity doubles
+    // when full, moving to the end of the arena (the slots it leaves aren't
+    // reused). a ring given a capacity with set_capacity is bounded, and
+    // drops packets past it as the overflow policy says.
+    struct packet_queues
+    {
+        // initial, for rings that grow.
+        static constexpr u32 default_capacity = 256;
+
+        struct statistics
+        {
+            // most packets queued at once for this id.
+            u32 high_water_mark = 0;
+            // packets discarded because the ring was full.
+            u64 dropped = 0;
+        };
+
+        // bounds a ring to capacity packets. only applies before its id is
+        // first pushed, as the slots are taken from the arena then.
+        auto set_capacity(u8 packet_id, u32 capacity) noexcept -> void
+        {
+            if (!rings[packet_id].allocated)
+            {
+                rings[packet_id].capacity = std::max<u32>(capacity, 1);
+                rings[packet_id].bounded = true;
+            }
+        };
+        auto set_overflow_policy(overflow_policy policy) noexcept -> void
+        {
+            overflow = policy;
+        };
+
+        // false if the packet was dropped, whether it was this one or not.
+        auto push(std::span<const std::byte> packet) -> bool
+        {
+            if (packet.size() < 2)
+            {
+                return false;
+            }
+
+            auto& ring = rings[u8(packet[0])];
+            if (!ring.allocated)
+            {
+                ring.base = u32(arena.size());
+                ring.allocated = true;
+                arena.resize(arena.size() + ring.capacity);
+            }
+
+            if (ring.count == ring.capacity && !ring.bounded)
+            {
+                grow(ring);
+            }
+
+            bool dropped = false;
+            if (ring.count == ring.capacity)
+            {
+                ++ring.stats.dropped;
+                if (overflow == overflow_policy::drop_newest)
+                {
+                    return false;
+                }
+                ring.head = ring.wrap(ring.head + 1);
+                --ring.count;
+                dropped = true;
+            }
+
+            arena[ring.base + ring.wrap(ring.head + ring.count)].assign(packet.data(), packet.size());
+            ++ring.count;
+            ring.stats.high_water_mark = std::max(ring.stats.high_water_mark, ring.count);
+            return !dropped;
+        };
+
+        [[nodiscard]]
+        auto size(u8 packet_id) const noexcept -> std::size_t
+        {
+            return rings[packet_id].count;
+        };
+        [[nodiscard]]
+        auto empty(u8 packet_id) const noexcept -> bool
+        {
+            return rings[packet_id].count == 0;
+        };
+        // the i'th oldest queued packet of an id. i must be less than size.
+        [[nodiscard]]
+        auto at(u8 packet_id, std::size_t i) const noexcept -> const packet_buffer&
+        {
+            const auto& ring = rings[packet_id];
+            return arena[ring.base + ring.wrap(ring.head + u32(i))];
+        };
+        [[nodiscard]]
+        auto front(u8 packet_id) const noexcept -> const packet_buffer&
+        {
+            return at(packet_id, 0);
+        };
+        // discards up to count of the oldest packets of an id.
+        auto pop(u8 packet_id, std::size_t count = 1) noexcept -> void
+        {
+            auto& ring = rings[packet_id];
+            u32 popped = u32(std::min<std::size_t>(count, ring.count));
+            if (popped != 0)
+            {
+                ring.head = ring.wrap(ring.head + popped);
+                ring.count -= popped;
+            }
+        };
+        // empties every ring, keeping the arena and the statistics.
+        auto clear() noexcept -> void
+        {
+            for (auto& ring : rings)
+            {
+                ring.head = 0;
+                ring.count = 0;
+            }
+        };
+
+        [[nodiscard]]
+        auto stats(u8 packet_id) const noexcept -> const statistics&
+        {
+            return rings[packet_id].stats;
+        };
+        auto reset_stats() noexcept -> void
+        {
+            for (auto& ring : rings)
+            {
+                ring.stats = { .high_water_mark = ring.count };
+            }
+        };
+
+    private:
+        struct ring
+        {
+            u32 base = 0;
+            u32 capacity = default_capacity;
+            u32 head = 0;
+            u32 count = 0;
+            bool allocated = false;
+            bool bounded = false;
+            statistics stats = {};
+
+            // i is never more than twice the capacity, so this beats a modulo.
+            auto wrap(u32 i) const noexcept -> u32
+            {
+                return i >= capacity ? i - capacity : i;
+            };
+        };
+
+        // twice the slots at the end of the arena, the packets first in order.
+        auto grow(ring& r) -> void
+        {
+            u32 base = u32(arena.size());
+            arena.resize(arena.size() + 2 * std::size_t(r.capacity));
+            for (u32 i = 0; i < r.count; ++i)
+            {
+                arena[base + i] = arena[r.base + r.wrap(r.head + i)];
+            }
+            r.base = base;
+            r.head = 0;
+            r.capacity *= 2;
+        };
+
+        std::array<ring, 256> rings = {};
+        std::vector<packet_buffer> arena = {};
+        overflow_policy overflow = overflow_policy::drop_oldest;
+    };
+};
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "general.hpp"
+#include "reflection.hpp"
+#include "host/entity_control.hpp"
+
+#include <bit>
+#include <type_traits>
+
+namespace cigi
+{
+    template <typename T>
+    struct member_pointer_traits;
+    template <typename C, typename M>
+    struct member_pointer_traits<M C::*>
+    {
+        using class_type = C;
+        using member_type = M;
+    };
+
+    namespace detail
+    {
+        // finds the byte the member starts at by comparing its address, in
+        // an object that's never constructed, with each byte overlaying it.
+        template <typename C, typename M>
+        consteval auto offset_of(M C::* member) -> std::size_t
+        {
+            union probe_t
+            {
+                std::byte bytes[sizeof(C)];
+                C object;
+
+                constexpr probe_t() : bytes{} {};
+                constexpr ~probe_t() {};
+            } probe;
+            for (std::size_t i = 0; i < sizeof(C); ++i)
+            {
+                if (static_cast<const void*>(&(probe.object.*member)) == static_cast<const void*>(&probe.bytes[i]))
+                {
+                    return i;
+                }
+            }
+            throw "member not found";
+        };
+    };
+
+    // byte offset of a (non-bitfield) member within its packet. packets have
+    // the same layout in memory as on the wire, so this is also the offset
+    // into a received packet, and agrees with T::fields.
+    template <auto member>
+    requires std::is_member_object_pointer_v<decltype(member)>
+    inline constexpr std::size_t member_offset = detail::offset_of(member);
+
+    // read-only, non-owning view of a packet inside a received datagram. fields
+    // are decoded on access, so nothing is copied that isn't asked for. the
+    // viewed bytes must outlive the view.
+    template <cigi_packet T>
+    struct basic_packet_view
+    {
+        using packet_type = T;
+
+        constexpr basic_packet_view() = default;
+        explicit basic_packet_view(std::span<const std::byte> data, std::endian order = std::endian::native) :
+            data{ data },
+            order{ order }
+        {};
+
+        // true when the bytes are long enough and carry T's packet id. as in
+        // datagram_index, a fixed-size packet may be longer than T (a newer
+        // minor version), and only T's part of it is read.
+        [[nodiscard]]
+        auto valid() const noexcept -> bool
+        {
+            return data.size() >= 2
+                && u8(data[0]) == decltype(T::packet_id)::value
+                && data.size() >= u8(data[1])
+                && (!is_constant_v<decltype(T::packet_size)> || u8(data[1]) >= sizeof(T));
+        };
+
+        [[nodiscard]]
+        auto packet_id() const noexcept -> u8
+        {
+            return u8(data[0]);
+        };
+        [[nodiscard]]
+        auto packet_size() const noexcept -> u8
+        {
+            return u8(data[1]);
+        };
+
+        // any addressable member, including either side of a union, e.g.
+        // view.get<&entity_control::latitude>() or <&entity_control::x_offset>.
+        template <auto member>
+        requires std::is_member_object_pointer_v<decltype(member)>
+              && std::same_as<typename member_pointer_traits<decltype(member)>::class_type, T>
+        [[nodiscard]]
+        auto get() const noexcept
+        {
+            using type = wire_type_t<typename member_pointer_traits<decltype(member)>::member_type>;
+            return load<type>(data.data() + member_offset<member>, order);
+        };
+
+        // any field by its name in T::fields, bitfields included, e.g.
+        // view.field<"entity_state">(). bitfields come back as a u8.
+        template <field_name name>
+        [[nodiscard]]
+        auto field() const noexcept
+        {
+            return read_field<T, field_index<T>(name.view())>(data, order);
+        };
+
+        // a bitfield member can't be named by pointer, so it's addressed by the
+        // byte it lives in and its position within that byte.
+        template <typename E>
+        [[nodiscard]]
+        auto bits(std::size_t offset, u8 shift, u8 width) const noexcept -> E
+        {
+            return E((u8(data[offset]) >> shift) & ((1u << width) - 1));
+        };
+
+        [[nodiscard]]
+        auto bytes() const noexcept -> std::span<const std::byte>
+        {
+            return data;
+        };
+        [[nodiscard]]
+        auto byte_order() const noexcept -> std::endian
+        {
+            return order;
+        };
+
+    protected:
+        std::span<const std::byte> data = {};
+        std::endian order = std::endian::native;
+    };
+
+    template <cigi_packet T>
+    struct packet_view : basic_packet_view<T>
+    {
+        using basic_packet_view<T>::basic_packet_view;
+    };
+
+    template <>
+    struct packet_view<entity_control> : basic_packet_view<entity_control>
+    {
+        using basic_packet_view<entity_control>::basic_packet_view;
+
+        auto entity_id() const noexcept -> u16
+        {
+            return get<&entity_control::entity_id>();
+        };
+        auto entity_state() const noexcept -> active_t
+        {
+            return bits<active_t>(4, 0, 2);
+        };
+        auto attach_state() const noexcept -> attach_t
+        {
+            return bits<attach_t>(4, 2, 1);
+        };
+        auto collision_detection_enable() const noexcept -> enable_t
+        {
+            return bits<enable_t>(4, 3, 1);
+        };
+        auto inherit_alpha() const noexcept -> inherit_t
+        {
+            return bits<inherit_t>(4, 4, 1);
+        };
+        auto ground_ocean_clamp() const noexcept -> entity_control::ground_ocean_clamp_t
+        {
+            return bits<entity_control::ground_ocean_clamp_t>(4, 5, 2);
+        };
+        auto animation_direction() const noexcept -> entity_control::animation_direction_t
+        {
+            return bits<entity_control::animation_direction_t>(5, 0, 1);
+        };
+        auto animation_loop_mode() const noexcept -> entity_control::animation_loop_mode_t
+        {
+            return bits<entity_control::animation_loop_mode_t>(5, 1, 1);
+        };
+        auto animation_state() const noexcept -> entity_control::animation_state_t
+        {
+            return bits<entity_control::animation_state_t>(5, 2, 2);
+        };
+        auto linear_extrapolation_interpolation_enable() const noexcept -> enable_t
+        {
+            return bits<enable_t>(5, 4, 1);
+        };
+        auto alpha() const noexcept -> u8
+        {
+            return get<&entity_control::alpha>();
+        };
+        auto entity_type() const noexcept -> u16
+        {
+            return get<&entity_control::entity_type>();
+        };
+        auto parent_id() const noexcept -> u16
+        {
+            return get<&entity_control::parent_id>();
+        };
+        auto roll() const noexcept -> f32
+        {
+            return get<&entity_control::roll>();
+        };
+        auto pitch() const noexcept -> f32
+        {
+            return get<&entity_control::pitch>();
+        };
+        auto yaw() const noexcept -> f32
+        {
+            return get<&entity_control::yaw>();
+        };
+        auto latitude() const noexcept -> f64
+        {
+            return get<&entity_control::latitude>();
+        };
+        auto longitude() const noexcept -> f64
+        {
+            return get<&entity_control::longitude>();
+        };
+        auto altitude() const noexcept -> f64
+        {
+            return get<&entity_control::altitude>();
+        };
+        auto x_offset() const noexcept -> f64
+        {
+            return get<&entity_control::x_offset>();
+        };
+        auto y_offset() const noexcept -> f64
+        {
+            return get<&entity_control::y_offset>();
+        };
+        auto z_offset() const noexcept -> f64
+        {
+            return get<&entity_control::z_offset>();
+        };
+    };
+};
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "general.hpp"
+
+#include "host/ig_control.hpp"
+#include "host/entity_control.hpp"
+#include "host/conformal_clamped_entity_control.hpp"
+#include "host/component_control.hpp"
+#include "host/short_component_control.hpp"
+#include "host/articulated_part_control.hpp"
+#include "host/short_articulated_part_control.hpp"
+#include "host/rate_control.hpp"
+#include "host/celestial_sphere_control.hpp"
+#include "host/atmosphere_control.hpp"
+#include "host/environmental_region_control.hpp"
+#include "host/weather_control.hpp"
+#include "host/maritime_surface_conditions_control.hpp"
+#include "host/wave_control.hpp"
+#include "host/terrestrial_surface_conditions_control.hpp"
+#include "host/view_control.hpp"
+#include "host/sensor_control.hpp"
+#include "host/motion_tracker_control.hpp"
+#include "host/earth_reference_model_definition.hpp"
+#include "host/trajectory_definition.hpp"
+#include "host/view_definition.hpp"
+#include "host/collision_detection_segment_definition.hpp"
+#include "host/collision_detection_volume_definition.hpp"
+#include "host/hat_hot_request.hpp"
+#include "host/line_of_sight_segment_request.hpp"
+#include "host/line_of_sight_vector_request.hpp"
+#include "host/position_request.hpp"
+#include "host/environmental_conditions_request.hpp"
+#include "host/symbol_surface_definition.hpp"
+#include "host/symbol_text_definition.hpp"
+#include "host/symbol_circle_definition.hpp"
+#include "host/symbol_line_definition.hpp"
+#include "host/symbol_clone.hpp"
+#include "host/symbol_control.hpp"
+#include "host/short_symbol_control.hpp"
+
+#include "ig/start_of_frame.hpp"
+#include "ig/hat_hot_response.hpp"
+#include "ig/hat_hot_extended_response.hpp"
+#include "ig/line_of_sight_response.hpp"
+#include "ig/line_of_sight_extended_response.hpp"
+#include "ig/sensor_response.hpp"
+#include "ig/sensor_extended_response.hpp"
+#include "ig/position_response.hpp"
+#include "ig/weather_conditions_response.hpp"
+#include "ig/aerosol_concentration_response.hpp"
+#include "ig/maritime_surface_conditions_response.hpp"
+#include "ig/terrestrial_surface_conditions_response.hpp"
+#include "ig/collision_detection_segment_notification.hpp"
+#include "ig/collision_detection_volume_notification.hpp"
+#include "ig/animation_stop_notification.hpp"
+#include "ig/event_notification.hpp"
+#include "ig/image_generator_message.hpp"
+
+namespace cigi
+{
+    template <cigi_packet... Ts>
+    struct packet_list
+    {
+        static constexpr std::size_t size = sizeof...(Ts);
+
+        // calls f.template operator()<T>() for each packet type, in order.
+        template <typename F>
+        static constexpr auto for_each(F&& f) -> void
+        {
+            (f.template operator()<Ts>(), ...);
+        };
+    };
+
+    template <typename A, typename B>
+    struct concat_packet_lists;
+    template <cigi_packet... As, cigi_packet... Bs>
+    struct concat_packet_lists<packet_list<As...>, packet_list<Bs...>>
+    {
+        using type = packet_list<As..., Bs...>;
+    };
+
+    // every packet the host sends, in packet id order.
+    using host_packets = packet_list<
+        ig_control,
+        entity_control,
+        conformal_clamped_entity_control,
+        component_control,
+        short_component_control,
+        articulated_part_control,
+        short_articulated_part_control,
+        rate_control,
+        celestial_sphere_control,
+        atmosphere_control,
+        environmental_region_control,
+        weather_control,
+        maritime_surface_conditions_control,
+        wave_control,
+        terrestrial_surface_conditions_control,
+        view_control,
+        sensor_control,
+        motion_tracker_control,
+        earth_reference_model_definition,
+        trajectory_definition,
+        view_definition,
+        collision_detection_segment_definition,
+        collision_detection_volume_definition,
+        hat_hot_request,
+        line_of_sight_segment_request,
+        line_of_sight_vector_request,
+        position_request,
+        environmental_conditions_request,
+        symbol_surface_definition,
+        symbol_text_definition,
+        symbol_circle_definition,
+        symbol_line_definition,
+        symbol_clone,
+        symbol_control,
+        short_symbol_control
+    >;
+    // every packet the IG sends, in packet id order.
+    using ig_packets = packet_list<
+        start_of_frame,
+        hat_hot_response,
+        hat_hot_extended_response,
+        line_of_sight_response,
+        line_of_sight_extended_response,
+        sensor_response,
+        sensor_extended_response,
+        position_response,
+        weather_conditions_response,
+        aerosol_concentration_response,
+        maritime_surface_conditions_response,
+        terrestrial_surface_conditions_response,
+        collision_detection_segment_notification,
+        collision_detection_volume_notification,
+        animation_stop_notification,
+        event_notification,
+        image_generator_message
+    >;
+    using all_packets = typename concat_packet_lists<host_packets, ig_packets>::type;
+};
\ No newline at end of file
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "general.hpp"
+
+#include <bit>
+#include <ostream>
+#include <utility>
+
+namespace cigi
+{
+    template <wire_t W>
+    struct wire_cpp;
+    template <> struct wire_cpp<wire_t::u8> { using type = u8; };
+    template <> struct wire_cpp<wire_t::s8> { using type = s8; };
+    template <> struct wire_cpp<wire_t::u16> { using type = u16; };
+    template <> struct wire_cpp<wire_t::s16> { using type = s16; };
+    template <> struct wire_cpp<wire_t::u32> { using type = u32; };
+    template <> struct wire_cpp<wire_t::s32> { using type = s32; };
+    template <> struct wire_cpp<wire_t::u64> { using type = u64; };
+    template <> struct wire_cpp<wire_t::s64> { using type = s64; };
+    template <> struct wire_cpp<wire_t::f32> { using type = f32; };
+    template <> struct wire_cpp<wire_t::f64> { using type = f64; };
+    template <wire_t W>
+    using wire_cpp_t = typename wire_cpp<W>::type;
+
+    // a string usable as a template argument, e.g. view.field<"entity_id">().
+    template <std::size_t N>
+    struct field_name
+    {
+        consteval field_name(const char (&name)[N])
+        {
+            std::copy(name, name + N, chars);
+        };
+        consteval auto view() const -> std::string_view
+        {
+            return { chars, N - 1 };
+        };
+
+        char chars[N];
+    };
+
+    // reads a T from possibly unaligned memory, swapping it if the data was
+    // written in the opposite byte order.
+    template <typename T>
+    requires std::is_trivially_copyable_v<T>
+    [[nodiscard]]
+    auto load(const std::byte* source, std::endian order = std::endian::native) noexcept -> T
+    {
+        T value;
+        std::memcpy(&value, source, sizeof(T));
+        if constexpr (sizeof(T) > 1)
+        {
+            if (order != std::endian::native)
+            {
+                if constexpr (std::is_enum_v<T>)
+                {
+                    value = T(std::byteswap(std::underlying_type_t<T>(value)));
+                }
+                else if constexpr (std::floating_point<T>)
+                {
+                    using bits = std::conditional_t<sizeof(T) == 4, u32, u64>;
+                    value = std::bit_cast<T>(std::byteswap(std::bit_cast<bits>(value)));
+                }
+                else
+                {
+                    value = std::byteswap(value);
+                }
+            }
+        }
+        return value;
+    };
+
+    // index into T::fields of the field with the given name.
+    template <cigi_packet T>
+    consteval auto field_index(std::string_view name) -> std::size_t
+    {
+        for (std::size_t i = 0; i < T::fields.size(); ++i)
+        {
+            if (T::fields[i].name == name)
+            {
+                return i;
+            }
+        }
+        throw "no field with this name";
+    };
+
+    // decodes one field of a packet in wire form. bitfields come back as the
+    // u8 they're stored in, shifted and masked.
+    template <cigi_packet T, std::size_t I>
+    [[nodiscard]]
+    auto read_field(std::span<const std::byte> packet, std::endian order = std::endian::native) noexcept
+    {
+        constexpr field_descriptor field = T::fields[I];
+        using type = wire_cpp_t<field.type>;
+        if constexpr (field.bit_width != 0)
+        {
+            return type((u8(packet[field.offset]) >> field.bit_offset) & ((1u << field.bit_width) - 1));
+        }
+        else
+        {
+            return load<type>(packet.data() + field.offset, order);
+        }
+    };
+
+    namespace detail
+    {
+        inline auto read_as_f64(const field_descriptor& field, const std::byte* base, std::endian order) noexcept -> f64
+        {
+            if (field.bit_width != 0)
+            {
+                return f64((u8(base[field.offset]) >> field.bit_offset) & ((1u << field.bit_width) - 1));
+            }
+
+            auto source = base + field.offset;
+            switch (field.type)
+            {
+            case wire_t::u8:
+                return f64(load<u8>(source, order));
+            case wire_t::s8:
+                return f64(load<s8>(source, order));
+            case wire_t::u16:
+                return f64(load<u16>(source, order));
+            case wire_t::s16:
+                return f64(load<s16>(source, order));
+            case wire_t::u32:
+                return f64(load<u32>(source, order));
+            case wire_t::s32:
+                return f64(load<s32>(source, order));
+            case wire_t::u64:
+                return f64(load<u64>(source, order));
+            case wire_t::s64:
+                return f64(load<s64>(source, order));
+            case wire_t::f32:
+                return f64(load<f32>(source, order));
+            case wire_t::f64:
+                return load<f64>(source, order);
+            }
+            return 0.0;
+        };
+
+        template <std::size_t N>
+        auto print(std::ostream& o, const std::array<field_descriptor, N>& fields, const std::byte* base, std::endian order, std::string_view indent) -> void
+        {
+            for (const auto& field : fields)
+            {
+                if (field.alias || field.reserved)
+                {
+                    continue;
+                }
+
+                o << '\n' << indent << field.name << ": ";
+                f64 value = read_as_f64(field, base, order);
+                if (field.type == wire_t::f32 || field.type == wire_t::f64)
+                {
+                    o << value;
+                }
+                else
+                {
+                    o << s64(value);
+                }
+            }
+        };
+
+        template <cigi_packet T>
+        constexpr auto fixed_size() -> std::size_t
+        {
+            std::size_t size = 0;
+            for (const auto& field : T::fields)
+            {
+                size = std::max<std::size_t>(size, field.offset + field.size);
+            }
+            return size;
+        };
+
+        template <auto& fields, std::size_t I>
+        auto validate_field(const std::byte* base, std::endian order) noexcept -> int
+        {
+            constexpr field_descriptor field = fields[I];
+            if constexpr (field.alias || field.reserved || !(field.constant || field.bounded))
+            {
+                return 0;
+            }
+            else
+            {
+                using type = wire_cpp_t<field.type>;
+                type value;
+                if constexpr (field.bit_width != 0)
+                {
+                    value = type((u8(base[field.offset]) >> field.bit_offset) & ((1u << field.bit_width) - 1));
+                }
+                else
+                {
+                    value = load<type>(base + field.offset, order);
+                }
+
+                if constexpr (field.selected)
+                {
+                    // the other side of the union is in use.
+                    if (((u8(base[field.selector_offset]) >> field.selector_bit_offset) & ((1u << field.selector_bit_width) - 1)) != field.selector_value)
+                    {
+                        return 0;
+                    }
+                }
+
+                int errors = 0;
+                if constexpr (field.constant)
+                {
+                    if (value != type(field.constant_value))
+                    {
+                        errors |= int(serialized_data::errors::mismatched_constant);
+                    }
+                }
+                if constexpr (field.bounded)
+                {
+                    // written so that NaN fails too.
+                    if (!(value >= type(field.lower) && value <= type(field.upper)))
+                    {
+                        errors |= int(serialized_data::errors::out_of_bounds);
+                    }
+                }
+                return errors;
+            }
+        };
+
+        // checks every field with a compile-time unrolled pass, so only the
+        // constant and bounded fields cost anything.
+        template <auto& fields>
+        auto validate(const std::byte* base, std::endian order) noexcept -> serialized_data::errors
+        {
+            return [&]<std::size_t... I>(std::index_sequence<I...>)
+            {
+                return serialized_data::errors((validate_field<fields, I>(base, order) | ... | 0));
+            }(std::make_index_sequence<fields.size()>{});
+        };
+
+        template <auto& fields>
+        auto byte_swap(std::byte* base) noexcept -> void
+        {
+            [&]<std::size_t... I>(std::index_sequence<I...>)
+            {
+                ([&]
+                {
+                    constexpr field_descriptor field = fields[I];
+                    if constexpr (!field.alias && field.bit_width == 0 && field.size > 1)
+                    {
+                        using bits = std::conditional_t<field.size == 2, u16, std::conditional_t<field.size == 4, u32, u64>>;
+                        bits value;
+                        std::memcpy(&value, base + field.offset, sizeof(bits));
+                        value = std::byteswap(value);
+                        std::memcpy(base + field.offset, &value, sizeof(bits));
+                    }
+                }(), ...);
+            }(std::make_index_sequence<fields.size()>{});
+        };
+
+        template <cigi_packet T>
+        constexpr auto element_size() -> std::size_t
+        {
+            std::size_t size = 0;
+            for (const auto& field : T::element_fields)
+            {
+                size = std::max<std::size_t>(size, field.offset + field.size);
+            }
+            return size;
+        };
+    };
+
+    // checks a packet in wire form against its field table: constant<> fields
+    // must hold their value (reserved ones are ignored, per the ICD), bounded<>
+    // fields must be in range, including those of each repeated element.
+    template <cigi_packet T>
+    [[nodiscard]]
+    auto validate_fields(std::span<const std::byte> packet, std::endian order = std::endian::native) noexcept -> serialized_data::errors
+    {
+        constexpr std::size_t fixed_size = detail::fixed_size<T>();
+        if (packet.size() < fixed_size)
+        {
+            return serialized_data::errors::truncated_packet;
+        }
+
+        int errors = int(detail::validate<T::fields>(packet.data(), order));
+        if constexpr (requires { T::element_fields; })
+        {
+            constexpr bool checked = std::ranges::any_of(T::element_fields, [](const auto& field)
+            {
+                return field.constant || field.bounded;
+            });
+            if constexpr (checked)
+            {
+                constexpr std::size_t element_size = detail::element_size<T>();
+                std::size_t end = std::min<std::size_t>(packet.size(), u8(packet[1]));
+                for (std::size_t offset = fixed_size; offset + element_size <= end; offset += element_size)
+                {
+                    errors |= int(detail::validate<T::element_fields>(packet.data() + offset, order));
+                }
+            }
+        }
+        return serialized_data::errors(errors);
+    };
+
+    // reverses the bytes of every field of a packet in place, elements
+    // included, with a compile-time unrolled pass over the field table.
+    template <cigi_packet T>
+    auto byte_swap_fields(std::span<std::byte> packet) noexcept -> void
+    {
+        constexpr std::size_t fixed_size = detail::fixed_size<T>();
+        if (packet.size() < fixed_size)
+        {
+            return;
+        }
+
+        detail::byte_swap<T::fields>(packet.data());
+        if constexpr (requires { T::element_fields; })
+        {
+            constexpr std::size_t element_size = detail::element_size<T>();
+            for (std::size_t offset = fixed_size; offset + element_size <= packet.size(); offset += element_size)
+            {
+                detail::byte_swap<T::element_fields>(packet.data() + offset);
+            }
+        }
+    };
+
+    // prints every non-reserved field of a packet in wire form by name, for
+    // diagnostics. the hand-written operator<< of each packet is friendlier.
+    template <cigi_packet T>
+    auto print_fields(std::ostream& o, std::span<const std::byte> packet, std::endian order = std::endian::native) -> std::ostream&
+    {
+        o << "{";
+        detail::print(o, T::fields, packet.data(), order, "\t");
+        if constexpr (requires { T::element_fields; })
+        {
+            constexpr std::size_t fixed_size = detail::fixed_size<T>();
+            constexpr std::size_t element_size = detail::element_size<T>();
+            std::size_t end = std::min<std::size_t>(packet.size(), u8(packet[1]));
+            for (std::size_t offset = fixed_size, i = 0; offset + element_size <= end; offset += element_size, ++i)
+            {
+                o << "\n\t" << i << ':';
+                detail::print(o, T::element_fields, packet.data() + offset, order, "\t  ");
+            }
+        }
+        return o << "\n}";
+    };
+};
\ No newline at end of file
@@ -0,0 +1,414 @@
+#pragma once
+
+#include "packets.hpp"
+#include "latency.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace cigi
+{
+    // the order outgoing packets go in when a frame is over budget.
+    enum class packet_priority : u8
+    {
+        // always sent, whatever the budget: the IG Control, own-ship
+        // updates.
+        immediate = 0,
+        high = 1,
+        normal = 2,
+        // sent last, and the first to be deferred: distant entities,
+        // environment controls, symbology.
+        low = 3,
+    };
+
+    // which bytes of a packet, from byte 2 on, say what it's the state of,
+    // e.g. an entity control's entity id. packets with the same id and key
+    // are newer and older states of the same thing.
+    struct packet_key
+    {
+        bool coalesced = false;
+        // bytes 2 to 8 of the packet.
+        std::array<u8, 7> mask = {};
+    };
+
+    // holds back what doesn't fit a per-frame byte budget until later frames.
+    // immediate packets always go; after them, deferred packets of each
+    // class ahead of its new ones, oldest first, from high to low. once one
+    // doesn't fit, everything after it waits for the next frame, so each
+    // deferred packet goes in turn instead of the small ones overtaking it.
+    // the first packet after the immediate ones always goes, so one larger
+    // than the budget leaves can't hold the rest back for good.
+    //
+    // a deferred packet with a key is replaced, in its place in line, by
+    // newer state written for the same key, so a frame never sends stale
+    // state along with or after the new, and the things waiting take turns.
+    //
+    // entity controls for the own-ship entity are immediate whatever their
+    // id's class. with no budget, nothing is held back and a frame goes in
+    // the order written.
+    struct packet_scheduler
+    {
+        static constexpr std::size_t class_count = 4;
+        static constexpr std::size_t default_deferred_limit = 4096;
+
+        struct statistics
+        {
+            // packets held back from the frame they were written in.
+            u64 deferred = 0;
+            // deferred packets replaced by newer state for the same key
+            // before they went.
+            u64 replaced = 0;
+            // packets dropped, oldest first, to keep the class under its
+            // limit of deferred packets.
+            u64 dropped = 0;
+            // the most frames a packet was held back for.
+            u32 max_frames = 0;
+            // how long sent packets had been held back, from when their key
+            // was first deferred.
+            latency_histogram age;
+        };
+
+        packet_scheduler()
+        {
+            defaults.fill(packet_priority::normal);
+            for (u8 id : { decltype(ig_control::packet_id)::value, decltype(start_of_frame::packet_id)::value })
+            {
+                defaults[id] = packet_priority::immediate;
+            }
+            for (u8 id : { decltype(celestial_sphere_control::packet_id)::value, decltype(atmosphere_control::packet_id)::value,
+                decltype(environmental_region_control::packet_id)::value, decltype(weather_control::packet_id)::value,
+                decltype(maritime_surface_conditions_control::packet_id)::value, decltype(wave_control::packet_id)::value,
+                decltype(terrestrial_surface_conditions_control::packet_id)::value, decltype(symbol_surface_definition::packet_id)::value,
+                decltype(symbol_text_definition::packet_id)::value, decltype(symbol_circle_definition::packet_id)::value,
+                decltype(symbol_line_definition::packet_id)::value, decltype(symbol_clone::packet_id)::value,
+                decltype(symbol_control::packet_id)::value, decltype(short_symbol_control::packet_id)::value })
+            {
+                defaults[id] = packet_priority::low;
+            }
+
+            // the short forms carry only part of the state, so aren't keyed.
+            constexpr u8 all = 0xff;
+            keys[decltype(entity_control::packet_id)::value] = { true, { all, all } };
+            keys[decltype(conformal_clamped_entity_control::packet_id)::value] = { true, { all, all } };
+            keys[decltype(articulated_part_control::packet_id)::value] = { true, { all, all, all } };
+            keys[decltype(rate_control::packet_id)::value] = { true, { all, all, all, 0x01 } };
+            keys[decltype(component_control::packet_id)::value] = { true, { all, all, all, all, 0x3f } };
+            keys[decltype(celestial_sphere_control::packet_id)::value] = { true, {} };
+            keys[decltype(atmosphere_control::packet_id)::value] = { true, {} };
+            keys[decltype(environmental_region_control::packet_id)::value] = { true, { all, all } };
+            keys[decltype(weather_control::packet_id)::value] = { true, { all, all, all, 0, 0, 0x03 } };
+            keys[decltype(maritime_surface_conditions_control::packet_id)::value] = { true, { all, all, 0x0c } };
+            keys[decltype(wave_control::packet_id)::value] = { true, { all, all, all, 0x06 } };
+            keys[decltype(terrestrial_surface_conditions_control::packet_id)::value] = { true, { all, all, all, all, 0x06 } };
+            for (u8 id : { decltype(symbol_surface_definition::packet_id)::value, decltype(symbol_text_definition::packet_id)::value,
+                decltype(symbol_circle_definition::packet_id)::value, decltype(symbol_line_definition::packet_id)::value,
+                decltype(symbol_clone::packet_id)::value, decltype(symbol_control::packet_id)::value })
+            {
+                keys[id] = { true, { all, all } };
+            }
+        };
+
+        // bytes per frame, immediate packets included. 0 is no budget.
+        auto set_budget(std::size_t bytes) noexcept -> void
+        {
+            budget = bytes;
+        };
+        [[nodiscard]]
+        auto frame_budget() const noexcept -> std::size_t
+        {
+            return budget;
+        };
+        // the class of packets with this id written without one.
+        auto set_priority(u8 packet_id, packet_priority priority) noexcept -> void
+        {
+            defaults[packet_id] = priority;
+        };
+        [[nodiscard]]
+        auto priority(u8 packet_id) const noexcept -> packet_priority
+        {
+            return defaults[packet_id];
+        };
+        // how deferred packets with this id are matched with newer state.
+        // a packet_key{} leaves them as written.
+        auto set_key(u8 packet_id, packet_key key) noexcept -> void
+        {
+            keys[packet_id] = key;
+        };
+        [[nodiscard]]
+        auto key(u8 packet_id) const noexcept -> const packet_key&
+        {
+            return keys[packet_id];
+        };
+        // the entity whose entity controls are always immediate, 0 by
+        // convention.
+        auto set_own_ship(u16 entity_id) noexcept -> void
+        {
+            own_ship = entity_id;
+        };
+        // most packets a class holds back at once.
+        auto set_deferred_limit(std::size_t packets) noexcept -> void
+        {
+            limit = std::max<std::size_t>(packets, 1);
+        };
+
+        // whether schedule has anything to do.
+        [[nodiscard]]
+        auto active() const noexcept -> bool
+        {
+            return budget != 0 || waiting != 0;
+        };
+        // packets held back now, per class or in all.
+        [[nodiscard]]
+        auto deferred(packet_priority priority) const noexcept -> std::size_t
+        {
+            return queues[std::size_t(priority)].size();
+        };
+        [[nodiscard]]
+        auto deferred() const noexcept -> std::size_t
+        {
+            return waiting;
+        };
+        [[nodiscard]]
+        auto stats(packet_priority priority) const noexcept -> const statistics&
+        {
+            return stats_by_class[std::size_t(priority)];
+        };
+
+        // picks this frame's packets from those written, classed by
+        // overrides (indices into written, in order) or else by id, and
+        // those held back. the spans are valid until finish, which is to be
+        // called once they're sent.
+        auto schedule(std::span<const serialized_data> written, std::span<const std::pair<std::size_t, packet_priority>> overrides) -> std::span<const std::span<const std::byte>>
+        {
+            ++frame;
+            selected.clear();
+            for (auto& held : held_back)
+            {
+                held.clear();
+            }
+            sent_from_queue.fill(0);
+
+            auto override = overrides.begin();
+            for (std::size_t i = 0; i < written.size(); ++i)
+            {
+                packet_priority priority = classify(written[i]);
+                if (override != overrides.end() && override->first == i)
+                {
+                    priority = (override++)->second;
+                }
+                held_back[std::size_t(priority)].push_back(i);
+            }
+
+            std::size_t used = 0;
+            for (std::size_t i : held_back[0])
+            {
+                selected.emplace_back(written[i].start_pointer(), written[i].size());
+                used += written[i].size();
+            }
+            held_back[0].clear();
+
+            // newer state for a key already waiting takes its place in line.
+            for (std::size_t c = 1; c < class_count; ++c)
+            {
+                auto& fresh = held_back[c];
+                std::size_t kept = 0;
+                for (std::size_t i : fresh)
+                {
+                    if (!replace(c, written[i]))
+                    {
+                        fresh[kept++] = i;
+                    }
+                }
+                fresh.resize(kept);
+            }
+
+            bool full = false;
+            bool progressed = false;
+            auto fits = [&](std::size_t size)
+            {
+                full = full || (budget != 0 && progressed && used + size > budget);
+                if (!full)
+                {
+                    used += size;
+                    progressed = true;
+                }
+                return !full;
+            };
+            for (std::size_t c = 1; c < class_count; ++c)
+            {
+                for (const auto& packet : queues[c])
+                {
+                    if (!fits(packet.data.size()))
+                    {
+                        break;
+                    }
+                    selected.emplace_back(packet.data.start_pointer(), packet.data.size());
+                    ++sent_from_queue[c];
+                }
+
+                // what fits is sent, and the rest kept in held_back.
+                auto& fresh = held_back[c];
+                std::size_t kept = 0;
+                for (std::size_t i : fresh)
+                {
+                    if (fits(written[i].size()))
+                    {
+                        selected.emplace_back(written[i].start_pointer(), written[i].size());
+                    }
+                    else
+                    {
+                        fresh[kept++] = i;
+                    }
+                }
+                fresh.resize(kept);
+            }
+            pending = written;
+            return selected;
+        };
+        // after the frame from schedule is sent: drops what went from the
+        // queues, recording how long it waited, and queues what didn't go.
+        auto finish() -> void
+        {
+            auto now = std::chrono::steady_clock::now();
+            for (std::size_t c = 1; c < class_count; ++c)
+            {
+                auto& queue = queues[c];
+                auto& stats = stats_by_class[c];
+                for (std::size_t i = 0; i < sent_from_queue[c]; ++i)
+                {
+                    stats.age.record(now - queue.front().since);
+                    stats.max_frames = std::max(stats.max_frames, frame - queue.front().frame);
+                    pop(c);
+                }
+
+                for (std::size_t i : held_back[c])
+                {
+                    // written twice this frame, and deferred both times.
+                    if (replace(c, pending[i]))
+                    {
+                        continue;
+                    }
+                    if (queue.size() == limit)
+                    {
+                        pop(c);
+                        ++stats.dropped;
+                    }
+
+                    auto key = key_of(pending[i]);
+                    u64 sequence = next_sequence[c]++;
+                    queue.push_back({ pending[i], frame, now, sequence, key.value_or(0), key.has_value() });
+                    if (key)
+                    {
+                        queued_keys[c][*key] = sequence;
+                    }
+                    ++stats.deferred;
+                }
+            }
+
+            waiting = 0;
+            for (const auto& queue : queues)
+            {
+                waiting += queue.size();
+            }
+            pending = {};
+        };
+
+    private:
+        auto classify(const serialized_data& packet) const -> packet_priority
+        {
+            u8 id = packet.packet_id();
+            if ((id == decltype(entity_control::packet_id)::value || id == decltype(conformal_clamped_entity_control::packet_id)::value) && packet.size() >= 4)
+            {
+                u16 entity_id = 0;
+                std::memcpy(&entity_id, packet.start_pointer() + 2, sizeof(entity_id));
+                if (entity_id == own_ship)
+                {
+                    return packet_priority::immediate;
+                }
+            }
+            return defaults[id];
+        };
+        // the packet id in the top byte, and the masked key bytes below.
+        auto key_of(const serialized_data& packet) const -> std::optional<u64>
+        {
+            u8 id = packet.packet_id();
+            const auto& spec = keys[id];
+            if (!spec.coalesced)
+            {
+                return std::nullopt;
+            }
+
+            u64 key = u64(id) << 56;
+            for (std::size_t b = 0; b < spec.mask.size() && 2 + b < packet.size(); ++b)
+            {
+                key |= u64(u8(packet.start_pointer()[2 + b]) & spec.mask[b]) << (8 * b);
+            }
+            return key;
+        };
+        // swaps packet in for the deferred packet with its key, if there is
+        // one, leaving when it was deferred as it was.
+        auto replace(std::size_t c, const serialized_data& packet) -> bool
+        {
+            auto key = key_of(packet);
+            if (!key)
+            {
+                return false;
+            }
+            auto it = queued_keys[c].find(*key);
+            if (it == queued_keys[c].end())
+            {
+                return false;
+            }
+
+            auto& queue = queues[c];
+            queue[std::size_t(it->second - queue.front().sequence)].data = packet;
+            ++stats_by_class[c].replaced;
+            return true;
+        };
+        auto pop(std::size_t c) -> void
+        {
+            const auto& front = queues[c].front();
+            if (front.keyed)
+            {
+                queued_keys[c].erase(front.key);
+            }
+            queues[c].pop_front();
+        };
+
+        struct deferred_packet
+        {
+            serialized_data data;
+            u32 frame = 0;
+            std::chrono::steady_clock::time_point since;
+            // consecutive within a queue, to find a keyed packet in it.
+            u64 sequence = 0;
+            u64 key = 0;
+            bool keyed = false;
+        };
+
+        std::size_t budget = 0;
+        std::size_t limit = default_deferred_limit;
+        u16 own_ship = 0;
+        std::array<packet_priority, 256> defaults;
+        std::array<packet_key, 256> keys = {};
+        u32 frame = 0;
+        std::size_t waiting = 0;
+        // by class. immediate packets are never queued.
+        std::array<std::deque<deferred_packet>, class_count> queues;
+        // the sequence of the deferred packet with each key, by class.
+        std::array<std::unordered_map<u64, u64>, class_count> queued_keys;
+        std::array<u64, class_count> next_sequence = {};
+        std::array<statistics, class_count> stats_by_class;
+
+        // between schedule and finish.
+        std::vector<std::span<const std::byte>> selected;
+        std::array<std::vector<std::size_t>, class_count> held_back;
+        std::array<std::size_t, class_count> sent_from_queue = {};
+        std::span<const serialized_data> pending;
+    };
+};
@@ -2,10 +2,25 @@
 
 #include "general.hpp"
 #include "socket.hpp"
+#include "shared_memory.hpp"
+#include "transport.hpp"
+#include "packet_view.hpp"
+#include "byte_swap.hpp"
+#include "columns.hpp"
+#include "datagram_index.hpp"
+#include "packet_queues.hpp"
+#include "datagram_ring.hpp"
+#include "frame_builder.hpp"
+#include "scheduler.hpp"
+#include "awaitable.hpp"
+#include "latency.hpp"
 
-#include <map>
+#include <functional>
 #include <future>
+#include <memory>
 #include <optional>
+#include <thread>
+#include <utility>
 
 namespace cigi
 {
@@ -13,13 +28,86 @@ namespace cigi
     {
         send_socket send;
         receive_socket receive;
+        // used instead of both sockets while set, e.g. to shared or to an end
+        // of a loopback_link. not owned.
+        transport* link = nullptr;
+        // see connect_shared.
+        shared_memory_channel shared;
         std::vector<serialized_data> outgoing;
-        std::map<u8, std::vector<serialized_data>> incoming;
+        // where each outgoing packet is, for the scatter-gather send.
+        std::vector<std::span<const std::byte>> outgoing_bytes;
+        // orders each flush into datagrams, and reports how full they were.
+        frame_builder frames;
+        // with a frame budget set, holds back what doesn't fit from each
+        // flush for later ones.
+        packet_scheduler scheduler;
+        // indices into outgoing of packets written with a priority, in order.
+        std::vector<std::pair<std::size_t, packet_priority>> priority_overrides;
+        // received packets by id, oldest first. see packet_queues for the
+        // capacity and overflow settings.
+        packet_queues incoming;
+        // byte order of the peer, as last seen in the magic number of an IG
+        // Control or Start of Frame. datagrams are swapped to native on receipt.
+        std::endian peer_byte_order = std::endian::native;
+        // the last datagram received, indexed. it points into the receive
+        // socket's batch pool or ring.
+        datagram_index index;
 
-        auto connect(std::string_view ip, std::uint16_t send_port, std::uint16_t receive_port, std::string_view receive_device = "")
+        // called with the bytes of one received packet, in native byte order.
+        using packet_handler = std::function<void(std::span<const std::byte>)>;
+        // indexed by packet id. packets with a handler are dispatched as their
+        // datagram is received instead of being queued.
+        std::array<packet_handler, 256> handlers;
+        // receives packets with no handler whose id has no known layout, e.g.
+        // user-defined packets. without one, they're queued like the rest.
+        packet_handler fallback;
+        // coroutines suspended in co_await next<T>, resumed from poll.
+        waiter_registry waiters;
+        // per packet id, the time from the kernel receiving a packet to it
+        // being dispatched. null unless latency tracking is on.
+        std::unique_ptr<std::array<latency_histogram, 256>> latencies;
+
+        // declared last, so the thread is stopped before anything it uses is
+        // destroyed.
+        std::unique_ptr<datagram_ring> ring;
+        std::jthread receiver;
+
+        session_network() = default;
+        // pending awaits are resumed with wait_error::cancelled.
+        ~session_network()
+        {
+            stop_receive_thread();
+            waiters.cancel_all();
+        };
+
+        // options apply to both sockets; returns what each made of them,
+        // send first.
+        auto connect(std::string_view ip, std::uint16_t send_port, std::uint16_t receive_port, std::string_view receive_device = "", const socket_options& options = {}) -> std::pair<socket_options_result, socket_options_result>
         {
-            send.connect(ip, send_port);
-            receive.connect("", receive_port, receive_device);
+            link = nullptr;
+            auto send_result = send.connect(ip, send_port, options);
+            auto receive_result = receive.connect("", receive_port, receive_device, options);
+            return { send_result, receive_result };
+        };
+        // sends and receives through link instead of the sockets, until
+        // connected otherwise. link must outlive the session.
+        auto connect(transport& link) -> void
+        {
+            this->link = &link;
+        };
+        // for a host and IG on the same machine: sends and receives through
+        // the named shared memory channel instead of the sockets, skipping
+        // the network stack. both sides open the same name, one as each
+        // role. poll, drain and flush work as over sockets; the receive
+        // thread and event_loop need the sockets.
+        auto connect_shared(std::string_view name, shared_memory_role role, std::size_t slots = shared_memory_channel::default_slots, std::size_t slot_size = shared_memory_channel::default_slot_size) -> bool
+        {
+            if (!shared.open(name, role, slots, slot_size))
+            {
+                return false;
+            }
+            link = &shared;
+            return true;
         };
 
         template <cigi_packet T>
@@ -32,91 +120,458 @@ namespace cigi
             }
             return errors;
         };
+        // as write, but scheduled as priority instead of by its id.
+        template <cigi_packet T>
+        auto write(const T& packet, packet_priority priority) -> serialized_data::errors
+        {
+            auto errors = write(packet);
+            if (errors == serialized_data::errors::none)
+            {
+                priority_overrides.emplace_back(outgoing.size() - 1, priority);
+            }
+            return errors;
+        };
+        // sends what's been written as one frame: the IG Control or Start of
+        // Frame first, and the rest packed into datagrams of up to the
+        // socket's or link's mtu by frames. with a frame budget, only what
+        // scheduler picks goes, and the rest in later frames.
         auto flush() -> void
         {
-            std::vector<std::byte> buffer;
-            buffer.reserve(outgoing.size() * 8);
-
-            for (auto& data : outgoing)
+            std::span<const std::span<const std::byte>> picked;
+            bool scheduled = scheduler.active();
+            if (scheduled)
             {
-                auto start = data.start_pointer();
-                std::copy(start, start + data.size(), std::back_inserter(buffer));
+                picked = scheduler.schedule(outgoing, priority_overrides);
+            }
+            else
+            {
+                outgoing_bytes.clear();
+                for (auto& data : outgoing)
+                {
+                    outgoing_bytes.emplace_back(data.start_pointer(), data.size());
+                }
+                picked = outgoing_bytes;
             }
 
-            send.send_bytes(buffer);
-            send.flush();
+            // sent from where they are, split just as frames laid them out.
+            send_packets(frames.build(picked, mtu()));
+            if (scheduled)
+            {
+                scheduler.finish();
+            }
             outgoing.clear();
+            priority_overrides.clear();
+        };
+        // sends the packets as they are, through the link or the socket,
+        // split into datagrams of up to mtu. returns the number of datagrams.
+        auto send_packets(std::span<const std::span<const std::byte>> packets) -> std::size_t
+        {
+            return link ? link->send_packets(packets) : send.send_packets(packets);
+        };
+        // largest datagram sent, in bytes.
+        [[nodiscard]]
+        auto mtu() const -> std::size_t
+        {
+            return link ? link->mtu() : send.mtu();
+        };
+
+        // dispatches every received T to handler, which takes either a
+        // packet_view<T> (nothing copied) or a const T& (deserialized first;
+        // packets that fail to deserialize are dropped). replaces any handler
+        // already set for T. handlers mustn't change handlers while running.
+        template <cigi_packet T, typename F>
+        requires std::invocable<F&, packet_view<T>> || std::invocable<F&, const T&>
+        auto on(F handler) -> void
+        {
+            handlers[decltype(T::packet_id)::value] = [handler = std::move(handler)](std::span<const std::byte> bytes) mutable
+            {
+                if constexpr (std::invocable<F&, packet_view<T>>)
+                {
+                    handler(packet_view<T>{ bytes });
+                }
+                else
+                {
+                    serialized_data data{ bytes.data(), bytes.size() };
+                    T packet;
+                    if (T::deserialize(data, packet) == serialized_data::errors::none)
+                    {
+                        handler(std::as_const(packet));
+                    }
+                }
+            };
+        };
+        // raw bytes of every packet with this id, e.g. a user-defined packet.
+        auto on(u8 packet_id, packet_handler handler) -> void
+        {
+            handlers[packet_id] = std::move(handler);
+        };
+        // packets of T are queued again.
+        template <cigi_packet T>
+        auto off() -> void
+        {
+            handlers[decltype(T::packet_id)::value] = nullptr;
+        };
+        auto on_unknown(packet_handler handler) -> void
+        {
+            fallback = std::move(handler);
+        };
+
+        // opt-in: a dedicated thread drains the receive socket into a ring of
+        // pooled datagram buffers, and poll consumes them from there without
+        // any syscalls while there are any. with a timeout and an empty ring,
+        // poll sleeps until the thread wakes it. datagrams that arrive while
+        // the ring is full are dropped and counted as overruns. slots hold a
+        // jumbo datagram by default; smaller ones truncate longer datagrams.
+        // returns false, starting nothing, for a session connected through a
+        // link or not connected at all, as the thread only reads the socket.
+        auto start_receive_thread(std::size_t slots = datagram_ring::default_slots, std::size_t slot_size = receive_socket::default_datagram_size) -> bool
+        {
+            stop_receive_thread();
+            if (link || receive.native_handle() == -1)
+            {
+                return false;
+            }
+            ring = std::make_unique<datagram_ring>(slots, slot_size);
+            receiver = std::jthread{ [this, scratch = std::vector<std::byte>(slot_size)](std::stop_token stop) mutable
+            {
+                using namespace std::chrono_literals;
+                while (!stop.stop_requested())
+                {
+                    // bounded, so a stop request is seen promptly.
+                    if (!receive.select(10'000us))
+                    {
+                        continue;
+                    }
+
+                    if (auto buffer = ring->acquire(); !buffer.empty())
+                    {
+                        if (int bytes = receive.read_into(buffer); bytes > 0)
+                        {
+                            ring->commit(std::size_t(bytes));
+                        }
+                    }
+                    else
+                    {
+                        receive.read_into(scratch);
+                    }
+                }
+            } };
+            return true;
+        };
+        auto stop_receive_thread() -> void
+        {
+            if (receiver.joinable())
+            {
+                receiver.request_stop();
+                receiver.join();
+            }
+            ring.reset();
+        };
+        // the receive thread's ring, for its occupancy and overrun counters.
+        // null unless the receive thread is running.
+        [[nodiscard]]
+        auto receive_ring() const noexcept -> const datagram_ring*
+        {
+            return ring.get();
         };
 
         // blocks until packets found or timeout.
         // consumes any packets found before returning. 
         // timeout of 0 is non-blocking, just an immediate poll.
+        // awaits whose deadline has passed are resumed with a timeout.
         auto poll(std::chrono::microseconds timeout) -> bool
         {
-            if (receive.select(timeout))
+            bool found = ring ? poll_ring(timeout) : poll_socket(timeout);
+            if (!waiters.empty())
             {
-                if (int bytes = receive.bytes_available(); bytes > 0)
+                expire_waits();
+            }
+            return found;
+        };
+        auto poll_socket(std::chrono::microseconds timeout) -> bool
+        {
+            bool ready = link ? link->wait(timeout) : receive.select(timeout);
+            return ready && receive_batch() != 0;
+        };
+        // reads and dispatches every datagram already waiting on a
+        // non-blocking receive socket, as an event loop does on readiness.
+        // returns the number of datagrams read.
+        auto drain() -> std::size_t
+        {
+            // a short batch means the socket was emptied, saving the call
+            // that would only find it so.
+            std::size_t count = 0;
+            while (std::size_t batch = receive_batch())
+            {
+                count += batch;
+                if (batch < (link ? link->batch_size() : receive.batch_size()))
                 {
-                    std::vector<std::byte> data;
-                    receive.read_bytes(bytes, data);
+                    break;
+                }
+            }
 
-                    std::size_t offset = 0;
-                    while (offset + 1 < bytes && u8(data[offset + 1]) != 0 && offset + u8(data[offset + 1]) <= bytes)
-                    {
-                        serialized_data serial{ data.data() + offset, std::size_t(data[offset + 1]) };
-                        u8 pid = serial.packet_id();
-                        incoming[pid].push_back(serial);
-                        offset += serial.packet_size();
-                    }
+            if (!waiters.empty())
+            {
+                expire_waits();
+            }
+            return count;
+        };
+        // dispatches one batch of datagrams straight from the socket's pool
+        // (see receive_socket::reserve_batch), or from the link. returns how
+        // many there were.
+        auto receive_batch() -> std::size_t
+        {
+            auto batch = link ? link->read_batch() : receive.read_batch();
+            for (const auto& datagram : batch)
+            {
+                receive_datagram(datagram.bytes, datagram.received_at);
+            }
+            return batch.size();
+        };
+        // consumes everything the receive thread has buffered, waiting for up
+        // to timeout if there's nothing yet.
+        auto poll_ring(std::chrono::microseconds timeout) -> bool
+        {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            bool consumed = false;
+            while (true)
+            {
+                while (auto datagram = ring->front())
+                {
+                    receive_datagram(*datagram);
+                    ring->pop();
+                    consumed = true;
+                }
 
-                    return true;
+                auto now = std::chrono::steady_clock::now();
+                if (consumed || now >= deadline)
+                {
+                    return consumed;
                 }
+                // asleep until the receive thread commits a datagram.
+                ring->wait(std::chrono::ceil<std::chrono::microseconds>(deadline - now));
+            }
+        };
+        // dispatches or queues every packet of one received datagram, swapping
+        // it to native byte order first if the peer's differs.
+        // received_at is the kernel's receive time, if known, for latency
+        // tracking.
+        auto receive_datagram(std::span<std::byte> data, std::chrono::system_clock::time_point received_at = {}) -> void
+        {
+            if (auto order = detect_byte_order(data); order.has_value())
+            {
+                peer_byte_order = order.value();
+            }
+            if (peer_byte_order != std::endian::native)
+            {
+                byte_swap_datagram(data);
             }
 
-            return false;
+            // packets of the wrong size for their id are dropped here, so
+            // nothing downstream reads past the end of one.
+            index.index(data);
+            if (latencies && received_at != std::chrono::system_clock::time_point{})
+            {
+                // one clock read per datagram; its packets dispatch together.
+                auto latency = std::chrono::system_clock::now() - received_at;
+                for (const auto& entry : index)
+                {
+                    (*latencies)[entry.packet_id].record(latency);
+                }
+            }
+            for (const auto& entry : index)
+            {
+                auto packet = index.packet(entry);
+                if (waiters.offer(packet))
+                {
+                    continue;
+                }
+                if (const auto& handler = handlers[entry.packet_id]; handler)
+                {
+                    handler(packet);
+                }
+                else if (fallback && !packet_sizes[entry.packet_id].known)
+                {
+                    fallback(packet);
+                }
+                else
+                {
+                    incoming.push(packet);
+                }
+            }
+            waiters.resume_ready();
+        };
+
+        // awaits the next received T, in a coroutine driven by poll:
+        //
+        //     std::expected<hat_hot_response, wait_error> response = co_await session.next<hat_hot_response>(deadline);
+        //
+        // a waiting T goes to the oldest matching await rather than to its
+        // handler or queue. any number may be outstanding; each costs a few
+        // pointers and a deadline entry.
+        template <cigi_packet T>
+        [[nodiscard]]
+        auto next(wait_clock::time_point deadline = wait_clock::time_point::max()) -> packet_awaiter<T>
+        {
+            return { waiters, any_packet{}, deadline };
+        };
+        // the next T whose request id (hat_hot_id, los_id, ...) is id.
+        template <cigi_packet T>
+        requires (has_request_id<T>())
+        [[nodiscard]]
+        auto next(u16 id, wait_clock::time_point deadline = wait_clock::time_point::max()) -> packet_awaiter<T>
+        {
+            return { waiters, id, deadline };
+        };
+        // the next T for which match(packet_view<T>) is true.
+        template <cigi_packet T, typename F>
+        requires std::predicate<const F&, packet_view<T>>
+        [[nodiscard]]
+        auto next(F match, wait_clock::time_point deadline = wait_clock::time_point::max()) -> packet_awaiter<T, F>
+        {
+            return { waiters, std::move(match), deadline };
+        };
+        // turns on kernel receive timestamps and starts recording
+        // wire-to-dispatch latency per packet id, clearing any recorded so
+        // far. false if the receive socket can't be stamped, in which case
+        // nothing is recorded; the receive thread's ring isn't stamped. over
+        // a link, what's recorded is from whatever time it stamps: the peer's
+        // flush, for shared memory, and none for a loopback_link.
+        auto track_latency(bool enable = true) -> bool
+        {
+            bool stamped = link ? true : receive.set_timestamps(enable);
+            if (enable)
+            {
+                latencies = std::make_unique<std::array<latency_histogram, 256>>();
+            }
+            else
+            {
+                latencies.reset();
+            }
+            return stamped;
+        };
+        // null unless latency tracking is on.
+        [[nodiscard]]
+        auto latency(u8 packet_id) const noexcept -> const latency_histogram*
+        {
+            return latencies ? &(*latencies)[packet_id] : nullptr;
+        };
+        template <cigi_packet T>
+        [[nodiscard]]
+        auto latency() const noexcept -> const latency_histogram*
+        {
+            return latency(decltype(T::packet_id)::value);
+        };
+
+        // resumes the awaits whose deadline is at or before now. poll does this
+        // already; an event loop that doesn't poll every session can call it.
+        auto expire_waits(wait_clock::time_point now = wait_clock::now()) -> void
+        {
+            waiters.expire(now);
+            waiters.resume_ready();
         };
         template <cigi_packet T>
         auto read() -> std::optional<T>
         {
-            auto find = incoming.find(decltype(T::packet_id)::value);
-            if (find != incoming.end())
+            constexpr u8 id = decltype(T::packet_id)::value;
+            if (!incoming.empty(id))
             {
-                if (!find->second.empty())
+                const auto& front = incoming.front(id);
+                serialized_data data{ front.data(), front.size() };
+                incoming.pop(id);
+
+                T packet;
+                if (T::deserialize(data, packet) == serialized_data::errors::none)
                 {
-                    T packet;
-                    auto errors = T::deserialize(find->second.front(), packet);
-                    find->second.erase(find->second.begin());
-                    if (errors == serialized_data::errors::none)
-                    {
-                        return packet;
-                    }
+                    return packet;
+                }
+            }
+
+            return std::nullopt;
+        };
+        // views the oldest queued T in place, without deserializing it. the
+        // view is valid until that packet is popped or more are received.
+        template <cigi_packet T>
+        auto peek() const -> std::optional<packet_view<T>>
+        {
+            constexpr u8 id = decltype(T::packet_id)::value;
+            if (!incoming.empty(id))
+            {
+                packet_view<T> view{ incoming.front(id) };
+                if (view.valid())
+                {
+                    return view;
                 }
             }
 
             return std::nullopt;
         };
+        // discards the oldest queued T, typically after peek.
+        template <cigi_packet T>
+        auto pop() -> bool
+        {
+            constexpr u8 id = decltype(T::packet_id)::value;
+            if (!incoming.empty(id))
+            {
+                incoming.pop(id);
+                return true;
+            }
+
+            return false;
+        };
         template <cigi_packet T>
         auto read_all() -> std::vector<T>
         {
+            constexpr u8 id = decltype(T::packet_id)::value;
             std::vector<T> out;
+            out.reserve(incoming.size(id));
 
-            auto find = incoming.find(decltype(T::packet_id)::value);
-            if (find != incoming.end())
+            for (std::size_t i = 0; i < incoming.size(id); ++i)
             {
-                while (!find->second.empty())
+                const auto& queued = incoming.at(id, i);
+                serialized_data data{ queued.data(), queued.size() };
+
+                T packet;
+                if (T::deserialize(data, packet) == serialized_data::errors::none)
                 {
-                    T packet;
-                    auto errors = T::deserialize(find->second.front(), packet);
-                    find->second.erase(find->second.begin());
-                    if (errors == serialized_data::errors::none)
+                    out.push_back(packet);
+                }
+            }
+            incoming.pop(id, incoming.size(id));
+
+            return out;
+        };
+        // decodes the named fields of the queued T's into columns, up to the
+        // shortest column's length, and discards them. see decode_columns.
+        // returns the number of rows written.
+        template <cigi_packet T, field_name... names>
+        requires (sizeof...(names) > 0)
+        auto read_columns(std::span<column_t<T, names>>... columns) -> std::size_t
+        {
+            constexpr u8 id = decltype(T::packet_id)::value;
+            std::size_t queued = incoming.size(id);
+            std::size_t capacity = std::min({ columns.size()... });
+            std::array<const std::byte*, detail::column_batch> packets;
+            std::size_t consumed = 0;
+            std::size_t rows = 0;
+            while (consumed < queued && rows < capacity)
+            {
+                std::size_t batched = 0;
+                for (; consumed < queued && batched < packets.size() && rows + batched < capacity; ++consumed)
+                {
+                    const auto& packet = incoming.at(id, consumed);
+                    if (packet.size() >= detail::fixed_size<T>())
                     {
-                        out.push_back(packet);
+                        packets[batched++] = packet.data();
                     }
                 }
+                rows += decode_columns<T, names...>(std::span{ packets.data(), batched }, columns.subspan(rows)...);
             }
-            
-            return out;
+            incoming.pop(id, consumed);
+
+            return rows;
         };
+        // one thread per call, polling for up to 10s; next<T> scales better.
         template <cigi_packet T>
         auto read_async(std::launch launch = std::launch::deferred) -> std::future<T>
         {
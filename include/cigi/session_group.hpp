@@ -0,0 +1,209 @@
+#pragma once
+
+#include "session.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace cigi
+{
+    // one frame of a session_group, serialized once for all its channels:
+    // the packets back to back in sending order, and the datagrams they
+    // split into. held by reference count, so a sender may keep one past the
+    // next flush; flush only reuses a frame nobody else holds.
+    struct shared_frame
+    {
+        std::vector<std::byte> bytes;
+        // spans of bytes, the first led by the IG Control.
+        std::vector<std::span<const std::byte>> datagrams;
+    };
+
+    // drives several IG channels that get the same stream, e.g. the
+    // projectors of a dome: packets written to the group are serialized and
+    // laid out once per frame, however many channels there are, and each
+    // channel's session sends the same datagrams.
+    //
+    //     cigi::session_group group;
+    //     for (auto& channel : channels)
+    //     {
+    //         group.add(channel);
+    //     }
+    //     group.write(ig_control);
+    //     group.write(entity);
+    //     group.write(2, view);
+    //     group.flush();
+    //
+    // packets for one channel alone, such as its View Control, are written
+    // with write(channel, packet) and go after the shared ones in that
+    // channel's frame. the sessions still receive as usual.
+    struct session_group
+    {
+        // orders each frame, as a session's frames does.
+        frame_builder frames;
+
+        // the session is sent to from flush, and must outlive the group or be
+        // removed first. returns the channel number.
+        auto add(session_network& channel) -> std::size_t
+        {
+            channels.push_back(&channel);
+            return channels.size() - 1;
+        };
+        auto remove(session_network& channel) -> void
+        {
+            std::erase(channels, &channel);
+        };
+        [[nodiscard]]
+        auto channel_count() const noexcept -> std::size_t
+        {
+            return channels.size();
+        };
+        [[nodiscard]]
+        auto channel(std::size_t i) const noexcept -> session_network&
+        {
+            return *channels[i];
+        };
+
+        // sends the shared datagrams once, to a multicast group all the
+        // channels' IGs have joined, instead of to each channel. packets for
+        // one channel still go through its session, in datagrams of their
+        // own led by a copy of the frame's IG Control.
+        auto connect_multicast(std::string_view ip, std::uint16_t port, const socket_options& options = {}) -> socket_options_result
+        {
+            multicast = std::make_unique<send_socket>();
+            return multicast->connect(ip, port, options);
+        };
+        auto disconnect_multicast() -> void
+        {
+            multicast.reset();
+        };
+
+        // for every channel.
+        template <cigi_packet T>
+        auto write(const T& packet) -> serialized_data::errors
+        {
+            auto [data, errors] = T::serialize(packet);
+            if (errors == serialized_data::errors::none)
+            {
+                outgoing.push_back(data);
+            }
+            return errors;
+        };
+        // for one channel alone.
+        template <cigi_packet T>
+        auto write(std::size_t channel, const T& packet) -> serialized_data::errors
+        {
+            return channels[channel]->write(packet);
+        };
+
+        // lays out what's been written as one frame, and sends it and each
+        // channel's own packets. the frame is built for the smallest mtu of
+        // the channels (or the multicast socket), so each sends it as the
+        // same datagrams. the channels' schedulers aren't used.
+        auto flush() -> void
+        {
+            build();
+            if (multicast)
+            {
+                multicast->send_packets(current->datagrams);
+            }
+
+            for (auto* channel : channels)
+            {
+                if (multicast)
+                {
+                    if (channel->outgoing.empty())
+                    {
+                        continue;
+                    }
+                    scratch.clear();
+                    if (auto lead = leading_packet(); !lead.empty())
+                    {
+                        scratch.push_back(lead);
+                    }
+                }
+                else
+                {
+                    scratch.assign(current->datagrams.begin(), current->datagrams.end());
+                }
+                for (auto& data : channel->outgoing)
+                {
+                    scratch.emplace_back(data.start_pointer(), data.size());
+                }
+                channel->send_packets(scratch);
+                channel->outgoing.clear();
+                channel->priority_overrides.clear();
+            }
+            outgoing.clear();
+        };
+
+        // the last frame built by flush.
+        [[nodiscard]]
+        auto frame() const noexcept -> std::shared_ptr<const shared_frame>
+        {
+            return current;
+        };
+
+    private:
+        // the IG Control (or Start of Frame) the frame starts with, if any.
+        auto leading_packet() const -> std::span<const std::byte>
+        {
+            if (current->datagrams.empty() || current->datagrams[0].size() < 2)
+            {
+                return {};
+            }
+            auto first = current->datagrams[0];
+            u8 id = u8(first[0]);
+            if (id != decltype(ig_control::packet_id)::value && id != decltype(start_of_frame::packet_id)::value)
+            {
+                return {};
+            }
+            return first.first(std::min<std::size_t>(u8(first[1]), first.size()));
+        };
+
+        auto build() -> void
+        {
+            std::size_t mtu = multicast ? multicast->mtu() : send_socket::jumbo_mtu;
+            for (auto* channel : channels)
+            {
+                mtu = std::min(mtu, channel->mtu());
+            }
+
+            packets.clear();
+            std::size_t size = 0;
+            for (auto& data : outgoing)
+            {
+                packets.emplace_back(data.start_pointer(), data.size());
+                size += data.size();
+            }
+            auto ordered = frames.build(packets, mtu);
+
+            if (!current || current.use_count() > 1)
+            {
+                current = std::make_shared<shared_frame>();
+            }
+            current->bytes.resize(size);
+            current->datagrams.clear();
+            std::byte* out = current->bytes.data();
+            for (const auto& datagram : frames.datagrams())
+            {
+                std::byte* start = out;
+                for (const auto& packet : ordered.subspan(datagram.first, datagram.count))
+                {
+                    std::memcpy(out, packet.data(), packet.size());
+                    out += packet.size();
+                }
+                current->datagrams.emplace_back(start, out);
+            }
+        };
+
+        std::vector<session_network*> channels;
+        std::unique_ptr<send_socket> multicast;
+        std::vector<serialized_data> outgoing;
+        std::shared_ptr<shared_frame> current;
+        // scratch for flush.
+        std::vector<std::span<const std::byte>> packets;
+        std::vector<std::span<const std::byte>> scratch;
+    };
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "transport.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace cigi
+{
+    // which end of a shared memory channel this is. each side sends on one
+    // ring and receives on the other.
+    enum class shared_memory_role : std::uint8_t
+    {
+        host = 0,
+        ig = 1,
+    };
+
+    // datagrams between a host and an IG on the same machine, through a pair
+    // of single-producer/single-consumer rings in a named POSIX shared memory
+    // region. a receiver with nothing to read sleeps on a futex the sender
+    // wakes only when someone is asleep, so a busy channel takes no syscalls
+    // at all. linux only; open fails elsewhere.
+    //
+    // datagrams are packed and split at packet boundaries like a socket's,
+    // with the slot size in place of the mtu, and are dropped and counted if
+    // the peer's ring is full.
+    struct shared_memory_channel : transport
+    {
+        static constexpr std::size_t default_slots = 64;
+        static constexpr std::size_t default_slot_size = 9216;
+
+        shared_memory_channel();
+        ~shared_memory_channel() override;
+
+        // creates the region named name (e.g. "/cigi-channel-0") or, if the
+        // other side already has, maps it; the sizes then come from the
+        // creator, which keeps slot_size within 256 to 65535 bytes. the
+        // creator unlinks the name when closed. false on failure, or if the
+        // region was made for another version of this.
+        auto open(std::string_view name, shared_memory_role role, std::size_t slots = default_slots, std::size_t slot_size = default_slot_size) -> bool;
+        auto close() -> void;
+        [[nodiscard]]
+        auto is_open() const -> bool;
+
+        // sends the packets, in order, as datagrams of up to the slot size,
+        // copying each into the peer's ring. returns the number of datagrams.
+        auto send_packets(std::span<const std::span<const std::byte>> packets) -> std::size_t override;
+        // waits for up to timeout for a datagram. true if one is waiting.
+        auto wait(std::chrono::microseconds timeout) -> bool override;
+        // every waiting datagram, up to the ring's size, read in place. the
+        // spans are valid until the next read_batch, which hands their slots
+        // back to the sender. received_at is when each was sent.
+        auto read_batch() -> std::span<const received_datagram> override;
+        [[nodiscard]]
+        auto batch_size() const -> std::size_t override;
+        // the slot size.
+        [[nodiscard]]
+        auto mtu() const -> std::size_t override;
+
+        // datagrams this side dropped because the peer's ring was full.
+        [[nodiscard]]
+        auto overruns() const -> std::uint64_t;
+        [[nodiscard]]
+        auto packets_sent() const -> std::uint64_t;
+
+    private:
+        struct shared_memory_channel_impl;
+        std::unique_ptr<shared_memory_channel_impl> impl;
+    };
+};
@@ -5,20 +5,132 @@
 #include <span>
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace cigi
 {
+    // how a socket makes its calls into the kernel.
+    enum class socket_backend : std::uint8_t
+    {
+        // plain BSD socket calls (recvmmsg/sendmmsg on linux).
+        bsd = 0,
+        // linux io_uring: sends are submitted as a batch, and a multishot
+        // receive fills a ring of registered buffers, so reading what's
+        // arrived takes no syscall.
+        io_uring = 1,
+        // io_uring with a kernel thread polling for submissions, so sending
+        // takes no syscall either, at the cost of that thread.
+        io_uring_polled = 2,
+    };
+    // whether this kernel can run the io_uring backends at all. sockets still
+    // fall back to bsd if a feature they need turns out to be missing.
+    auto io_uring_available() -> bool;
+
+    // settings applied as a socket connects. options left unset keep the
+    // system default.
+    struct socket_options
+    {
+        // SO_RCVBUF / SO_SNDBUF, in bytes. if the system maximum is lower,
+        // the FORCE variants are tried, which need CAP_NET_ADMIN.
+        std::optional<int> receive_buffer;
+        std::optional<int> send_buffer;
+        // SO_BUSY_POLL: microseconds to busy-wait on the device queue for a
+        // blocking read (linux).
+        std::optional<int> busy_poll;
+        // SO_PRIORITY, the queueing priority (linux).
+        std::optional<int> priority;
+        // IP_TOS from a DSCP code point (0 to 63), e.g. 46 for expedited
+        // forwarding.
+        std::optional<std::uint8_t> dscp;
+        // IP_MULTICAST_TTL and IP_MULTICAST_LOOP, for multicast sends.
+        std::optional<int> multicast_ttl;
+        std::optional<bool> multicast_loop;
+        bool non_blocking = false;
+    };
+
+    // what became of a socket_options field.
+    enum class option_result : std::uint8_t
+    {
+        unset = 0,
+        honored = 1,
+        // refused, or for buffer sizes, given less than asked for.
+        rejected = 2,
+    };
+
+    struct socket_options_result
+    {
+        option_result receive_buffer = option_result::unset;
+        option_result send_buffer = option_result::unset;
+        option_result busy_poll = option_result::unset;
+        option_result priority = option_result::unset;
+        option_result dscp = option_result::unset;
+        option_result multicast_ttl = option_result::unset;
+        option_result multicast_loop = option_result::unset;
+        option_result non_blocking = option_result::unset;
+        // the buffer sizes in effect, read back whether set or not. linux
+        // reports double the size asked for, counting its bookkeeping.
+        int receive_buffer_size = 0;
+        int send_buffer_size = 0;
+
+        // true if nothing set was rejected.
+        [[nodiscard]]
+        auto all_honored() const noexcept -> bool
+        {
+            for (auto result : { receive_buffer, send_buffer, busy_poll, priority, dscp, multicast_ttl, multicast_loop, non_blocking })
+            {
+                if (result == option_result::rejected)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+    };
+
+    // one datagram of a batch, in the receive socket's buffer pool.
+    struct received_datagram
+    {
+        std::span<std::byte> bytes;
+        // IPv4 address and port of the sender, in host byte order.
+        std::uint32_t source_address = 0;
+        std::uint16_t source_port = 0;
+        // the datagram was longer than a pool buffer and was cut short.
+        bool truncated = false;
+        // when the kernel received it, if receive timestamps are on.
+        // otherwise zero.
+        std::chrono::system_clock::time_point received_at = {};
+    };
+
     struct send_socket
     {
         send_socket();
         ~send_socket();
 
-        auto connect(std::string_view ip, std::uint16_t port) -> void;
+        auto connect(std::string_view ip, std::uint16_t port, const socket_options& options = {}) -> socket_options_result;
         auto disconnect() -> void;
         auto send_bytes(std::span<std::byte> bytes) -> void;
         auto flush() -> void;
-        
+        // sends the packets, in order, as datagrams of up to mtu bytes split
+        // only between packets (scatter-gather; sendmmsg on linux, so usually
+        // one call). nothing is copied. returns the number of datagrams the
+        // kernel took, which is what packets_sent counts.
+        auto send_packets(std::span<const std::span<const std::byte>> packets) -> std::size_t;
+
+        // largest datagram send_bytes and send_packets build, in bytes. the
+        // default suits a 1500 byte ethernet MTU; raise it for jumbo frames.
+        static constexpr std::size_t default_mtu = 1432;
+        // a 9000 byte jumbo frame, less the IP and UDP headers.
+        static constexpr std::size_t jumbo_mtu = 8972;
+        auto set_mtu(std::size_t mtu) -> void;
+        auto mtu() const -> std::size_t;
+
+        // the backend in use, which is bsd if the one asked for isn't
+        // supported. only send_packets uses io_uring.
+        auto set_backend(socket_backend backend) -> socket_backend;
+        auto backend() const -> socket_backend;
+
+        // datagrams sent.
         auto packets_sent() const -> std::uint64_t;
         auto bytes_sent() const -> std::uint64_t;
 
@@ -32,12 +144,44 @@ namespace cigi
         receive_socket();
         ~receive_socket();
 
-        auto connect(std::string_view ip, std::uint16_t port, std::string_view device) -> void;
+        auto connect(std::string_view ip, std::uint16_t port, std::string_view device, const socket_options& options = {}) -> socket_options_result;
         auto disconnect() -> void;
         auto bytes_available() const -> int;
         auto read_bytes(int size, std::vector<std::byte>& data) const -> bool;
+        // receives one datagram into buffer, truncating it if it doesn't fit.
+        // returns the bytes received, or -1 on failure.
+        auto read_into(std::span<std::byte> buffer) const -> int;
         auto select(std::chrono::microseconds timeout) const -> bool;
 
+        static constexpr std::size_t default_batch_size = 16;
+        static constexpr std::size_t default_datagram_size = 9216;
+        // allocates the pool read_batch receives into: count buffers of
+        // datagram_size bytes, reused by every batch.
+        auto reserve_batch(std::size_t count = default_batch_size, std::size_t datagram_size = default_datagram_size) -> void;
+        // receives up to the pool's count of datagrams in one call (recvmmsg
+        // on linux), blocking for the first only if the socket is blocking.
+        // the spans are valid until the next read_batch or reserve_batch.
+        // reserves the default pool if there's none yet.
+        auto read_batch() -> std::span<const received_datagram>;
+        // datagrams per batch, or 0 before the pool is reserved.
+        auto batch_size() const -> std::size_t;
+        // a non-blocking socket's reads return -1 at once when nothing's
+        // waiting, as an edge-triggered event loop needs.
+        auto set_blocking(bool blocking) -> bool;
+        // stamps each batched datagram with the kernel's receive time
+        // (SO_TIMESTAMPNS, linux only). applies from connect if not connected
+        // yet. true if the kernel took it.
+        auto set_timestamps(bool enable) -> bool;
+        // the backend in use, which is bsd if the one asked for isn't
+        // supported. applies from connect if not connected yet.
+        auto set_backend(socket_backend backend) -> socket_backend;
+        auto backend() const -> socket_backend;
+        // the descriptor that becomes readable when datagrams arrive (the
+        // socket, or the io_uring), or -1 when not connected. set_backend
+        // can change it, so choose the backend before waiting on it, e.g.
+        // before event_loop::add; reserve_batch and set_timestamps keep it.
+        auto native_handle() const -> std::intptr_t;
+
     private:
         struct receive_socket_impl;
         std::unique_ptr<receive_socket_impl> impl;
@@ -0,0 +1,522 @@
+#pragma once
+
+#include "session.hpp"
+
+#include <bit>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cigi
+{
+    // the last state set for each key, serialized, and which keys changed
+    // since they were last emitted.
+    template <cigi_packet T>
+    struct mirror_table
+    {
+        struct entry
+        {
+            std::array<std::byte, sizeof(T)> bytes = {};
+            // as last emitted, if last_sent isn't 0.
+            std::array<std::byte, sizeof(T)> sent = {};
+            u64 key = 0;
+            u32 last_sent = 0;
+            bool dirty = false;
+            // written in full on the next emit, whatever changed.
+            bool full = false;
+        };
+
+        std::vector<entry> entries;
+        std::unordered_map<u64, u32> index;
+        // entries changed since the last emit, in the order they changed.
+        std::vector<u32> dirty;
+
+        // true if packet differs from the state held for key, which is new
+        // if there's none.
+        auto set(u64 key, const T& packet) -> bool
+        {
+            std::array<std::byte, sizeof(T)> bytes;
+            if (T::serialize_into(packet, bytes).second != serialized_data::errors::none)
+            {
+                return false;
+            }
+
+            auto [it, added] = index.try_emplace(key, u32(entries.size()));
+            if (added)
+            {
+                entries.push_back({ .key = key });
+            }
+            entry& e = entries[it->second];
+            if (!added && std::memcmp(e.bytes.data(), bytes.data(), bytes.size()) == 0)
+            {
+                return false;
+            }
+
+            e.bytes = bytes;
+            if (!e.dirty)
+            {
+                e.dirty = true;
+                dirty.push_back(it->second);
+            }
+            return true;
+        };
+        // erases the entries whose key erased(key) is true. pending changes to
+        // the rest stay pending, in order.
+        template <typename F>
+        auto erase_if(F&& erased) -> void
+        {
+            std::vector<u64> dirty_keys;
+            for (u32 i : dirty)
+            {
+                dirty_keys.push_back(entries[i].key);
+            }
+
+            // each erased entry is swapped with the last.
+            for (std::size_t i = entries.size(); i-- > 0;)
+            {
+                if (erased(entries[i].key))
+                {
+                    index.erase(entries[i].key);
+                    if (i + 1 != entries.size())
+                    {
+                        entries[i] = entries.back();
+                        index[entries[i].key] = u32(i);
+                    }
+                    entries.pop_back();
+                }
+            }
+
+            dirty.clear();
+            for (u64 key : dirty_keys)
+            {
+                if (auto it = index.find(key); it != index.end())
+                {
+                    dirty.push_back(it->second);
+                }
+            }
+        };
+
+        // calls write(entry, changed) for the changed entries, then for
+        // those due a refresh: with an interval of n frames, entry i is
+        // refreshed on the frames where frame % n == i % n, spreading the
+        // refreshes evenly. changed is false for a refresh, for an entry
+        // never written before, one marked but as sent, or one marked by
+        // mark_all. returns the number of each written.
+        template <typename F>
+        auto emit(u32 frame, u32 interval, F&& write) -> std::pair<std::size_t, std::size_t>
+        {
+            std::size_t changed = dirty.size();
+            for (u32 i : dirty)
+            {
+                entry& e = entries[i];
+                write(std::as_const(e), !e.full && e.last_sent != 0 && e.bytes != e.sent);
+                e.sent = e.bytes;
+                e.dirty = false;
+                e.full = false;
+                e.last_sent = frame;
+            }
+            dirty.clear();
+
+            std::size_t refreshed = 0;
+            if (interval != 0)
+            {
+                for (std::size_t i = frame % interval; i < entries.size(); i += interval)
+                {
+                    entry& e = entries[i];
+                    if (e.last_sent != frame)
+                    {
+                        write(std::as_const(e), false);
+                        e.sent = e.bytes;
+                        e.last_sent = frame;
+                        ++refreshed;
+                    }
+                }
+            }
+            return { changed, refreshed };
+        };
+        // every entry is written in full on the next emit.
+        auto mark_all() -> void
+        {
+            for (u32 i = 0; i < entries.size(); ++i)
+            {
+                entries[i].full = true;
+                if (!entries[i].dirty)
+                {
+                    entries[i].dirty = true;
+                    dirty.push_back(i);
+                }
+            }
+        };
+    };
+
+    // the host's view of what the IG has been told about entities, their
+    // articulated parts and components, and symbols, so each frame sends
+    // only what changed. set the whole state every frame as before, then
+    // emit:
+    //
+    //     mirror.set(entity);            // for every entity
+    //     mirror.set(part);              // ...and part, component and symbol
+    //     mirror.emit(session);          // only the changes are written
+    //     session.flush();
+    //
+    // packets are compared as serialized, and written from there without
+    // serializing them again. a change small enough goes as the short form
+    // of its packet: one or two DOFs of articulated parts, where two parts
+    // of an entity with one DOF changed each share a packet; component data
+    // that fits in two words; or up to two symbol attributes. as a guard
+    // against lost datagrams, every packet is also re-sent in full once per
+    // refresh interval, spread across the frames of the interval.
+    struct state_mirror
+    {
+        static constexpr u32 default_refresh_interval = 60;
+
+        struct emit_counts
+        {
+            // packets written because they changed, or were new.
+            std::size_t changed = 0;
+            // of those, the ones written in a short form.
+            std::size_t shortened = 0;
+            // unchanged packets written as their refresh came round.
+            std::size_t refreshed = 0;
+            // packets held, after the emit.
+            std::size_t held = 0;
+        };
+
+        // in frames, i.e. calls to emit. 0 turns refreshing off.
+        explicit state_mirror(u32 refresh_interval = default_refresh_interval) :
+            interval{ refresh_interval }
+        {};
+
+        auto set_refresh_interval(u32 frames) noexcept -> void
+        {
+            interval = frames;
+        };
+        [[nodiscard]]
+        auto refresh_interval() const noexcept -> u32
+        {
+            return interval;
+        };
+        // on by default. turn off for an IG that doesn't take the short
+        // packets.
+        auto set_short_packets(bool enable) noexcept -> void
+        {
+            shorten = enable;
+        };
+
+        // an entity set destroyed is sent once more, then forgotten along
+        // with its parts and components. likewise a destroyed symbol.
+        auto set(const entity_control& packet) -> bool
+        {
+            if (packet.entity_state == active_t::destroyed)
+            {
+                destroyed.insert(packet.entity_id);
+            }
+            return entities.set(packet.entity_id, packet);
+        };
+        auto set(const articulated_part_control& packet) -> bool
+        {
+            return parts.set(part_key(packet.entity_id, packet.articulated_part_id), packet);
+        };
+        auto set(const component_control& packet) -> bool
+        {
+            return components.set(component_key(packet.component_class, packet.instance_id, packet.component_id), packet);
+        };
+        auto set(const symbol_control& packet) -> bool
+        {
+            if (packet.symbol_state == symbol_control::symbol_state_t::destroyed)
+            {
+                destroyed_symbols.insert(packet.symbol_id);
+            }
+            return symbols.set(packet.symbol_id, packet);
+        };
+        // forgets an entity and its parts and components without sending
+        // anything, e.g. once the IG has been told to destroy it some other
+        // way.
+        auto erase_entity(u16 entity_id) -> void
+        {
+            destroyed.erase(entity_id);
+            forget({ entity_id });
+        };
+
+        // writes this frame's changes and refreshes to session, entities
+        // first, so a new entity is created before its parts. call once per
+        // frame, before flushing.
+        auto emit(session_network& session) -> emit_counts
+        {
+            ++frame;
+            emit_counts counts;
+            auto add = [&](std::pair<std::size_t, std::size_t> written)
+            {
+                counts.changed += written.first;
+                counts.refreshed += written.second;
+            };
+            auto write_full = [&](const auto& entry, bool)
+            {
+                session.outgoing.emplace_back(entry.bytes.data(), entry.bytes.size());
+            };
+
+            add(entities.emit(frame, interval, write_full));
+            add(parts.emit(frame, interval, [&](const auto& entry, bool changed)
+            {
+                if (!(changed && shorten && write_short_part(session, entry)))
+                {
+                    write_full(entry, changed);
+                }
+            }));
+            for (const auto& [entity_id, dof] : unpaired)
+            {
+                write_dofs(session, entity_id, dof, dof);
+            }
+            unpaired.clear();
+            add(components.emit(frame, interval, [&](const auto& entry, bool changed)
+            {
+                if (!(changed && shorten && write_short_component(session, entry)))
+                {
+                    write_full(entry, changed);
+                }
+            }));
+            add(symbols.emit(frame, interval, [&](const auto& entry, bool changed)
+            {
+                if (!(changed && shorten && write_short_symbol(session, entry)))
+                {
+                    write_full(entry, changed);
+                }
+            }));
+            counts.shortened = shortened;
+            shortened = 0;
+
+            if (!destroyed.empty())
+            {
+                forget(destroyed);
+                destroyed.clear();
+            }
+            if (!destroyed_symbols.empty())
+            {
+                symbols.erase_if([&](u64 key) { return destroyed_symbols.contains(u16(key)); });
+                destroyed_symbols.clear();
+            }
+            counts.held = entities.entries.size() + parts.entries.size() + components.entries.size() + symbols.entries.size();
+            return counts;
+        };
+        // everything held is written in full on the next emit, e.g. after
+        // the IG restarts.
+        auto refresh_all() -> void
+        {
+            entities.mark_all();
+            parts.mark_all();
+            components.mark_all();
+            symbols.mark_all();
+        };
+
+        [[nodiscard]]
+        auto entity_count() const noexcept -> std::size_t
+        {
+            return entities.entries.size();
+        };
+
+    private:
+        // one changed DOF of a part, waiting for another part of its entity
+        // to share a short packet with.
+        struct part_dof
+        {
+            u8 part_id = 0;
+            enable_t enable = enable_t::disabled;
+            short_articulated_part_control::dof_select_t select = short_articulated_part_control::dof_select_t::not_used;
+            f32 value = 0.f;
+        };
+
+        template <cigi_packet T, std::size_t N>
+        static auto unpack(const std::array<std::byte, N>& bytes) -> T
+        {
+            serialized_data data{ bytes.data(), bytes.size() };
+            T packet;
+            T::deserialize(data, packet);
+            return packet;
+        };
+        // compared as bits, as the serialized packets are.
+        static auto same(f32 a, f32 b) noexcept -> bool
+        {
+            return std::bit_cast<u32>(a) == std::bit_cast<u32>(b);
+        };
+
+        // a part whose enables are as sent, with one or two enabled DOFs
+        // changed. a single DOF waits in unpaired for a second part of the
+        // same entity; a packet for one part only sets dof_select_2 unused.
+        template <typename E>
+        auto write_short_part(session_network& session, const E& entry) -> bool
+        {
+            using select = short_articulated_part_control::dof_select_t;
+            auto now = unpack<articulated_part_control>(entry.bytes);
+            auto before = unpack<articulated_part_control>(entry.sent);
+            auto enables = [](const articulated_part_control& p)
+            {
+                return std::array{ p.articulated_part_enable, p.x_offset_enable, p.y_offset_enable, p.z_offset_enable, p.yaw_enable, p.pitch_enable, p.roll_enable };
+            };
+            if (enables(now) != enables(before))
+            {
+                return false;
+            }
+
+            // in dof_select order.
+            std::array<f32, 6> values{ now.x_offset, now.y_offset, now.z_offset, now.yaw, now.pitch, now.roll };
+            std::array<f32, 6> old_values{ before.x_offset, before.y_offset, before.z_offset, before.yaw, before.pitch, before.roll };
+            auto enabled = enables(now);
+            std::array<part_dof, 2> changed;
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                if (!same(values[i], old_values[i]))
+                {
+                    if (count == 2 || enabled[i + 1] != enable_t::enabled)
+                    {
+                        return false;
+                    }
+                    changed[count++] = { now.articulated_part_id, now.articulated_part_enable, select(i + 1), values[i] };
+                }
+            }
+            if (count == 0)
+            {
+                return false;
+            }
+
+            ++shortened;
+            if (count == 2)
+            {
+                write_dofs(session, now.entity_id, changed[0], changed[1]);
+            }
+            else if (auto it = unpaired.find(now.entity_id); it != unpaired.end())
+            {
+                write_dofs(session, now.entity_id, it->second, changed[0]);
+                unpaired.erase(it);
+            }
+            else
+            {
+                unpaired.emplace(now.entity_id, changed[0]);
+            }
+            return true;
+        };
+        auto write_dofs(session_network& session, u16 entity_id, const part_dof& first, const part_dof& second) -> void
+        {
+            short_articulated_part_control packet;
+            packet.entity_id = entity_id;
+            packet.articulated_part_id[0] = first.part_id;
+            packet.articulated_part_id[1] = second.part_id;
+            packet.dof_select_1 = first.select;
+            packet.dof_select_2 = &first == &second ? short_articulated_part_control::dof_select_t::not_used : second.select;
+            packet.articulated_part_enable_1 = first.enable;
+            packet.articulated_part_enable_2 = second.enable;
+            // the union's members are all 4 byte floats.
+            packet.dof[0].x_offset = first.value;
+            packet.dof[1].x_offset = second.value;
+            session.write(packet);
+        };
+
+        // component data that fits the short packet's two words, before and
+        // after.
+        template <typename E>
+        auto write_short_component(session_network& session, const E& entry) -> bool
+        {
+            auto now = unpack<component_control>(entry.bytes);
+            auto before = unpack<component_control>(entry.sent);
+            for (std::size_t i = 2; i < 6; ++i)
+            {
+                if (now.component_data[i] != 0 || before.component_data[i] != 0)
+                {
+                    return false;
+                }
+            }
+
+            short_component_control packet;
+            packet.component_id = now.component_id;
+            packet.instance_id = now.instance_id;
+            packet.component_class = now.component_class;
+            packet.component_state = now.component_state;
+            packet.component_data[0] = now.component_data[0];
+            packet.component_data[1] = now.component_data[1];
+            session.write(packet);
+            ++shortened;
+            return true;
+        };
+
+        // up to two attributes changed. the state and flags go either way.
+        template <typename E>
+        auto write_short_symbol(session_network& session, const E& entry) -> bool
+        {
+            auto now = unpack<symbol_control>(entry.bytes);
+            auto before = unpack<symbol_control>(entry.sent);
+
+            short_symbol_control packet;
+            packet.symbol_id = now.symbol_id;
+            packet.symbol_state = now.symbol_state;
+            packet.attach_state = now.attach_state;
+            packet.flash_control = now.flash_control;
+            packet.inherit_color = now.inherit_color;
+
+            u8 count = 0;
+            auto attribute = [&](bool changed, auto&& set)
+            {
+                if (changed)
+                {
+                    if (count < 2)
+                    {
+                        set(count);
+                    }
+                    ++count;
+                }
+            };
+            attribute(now.surface_id != before.surface_id, [&](u8 i) { packet.set_surface_id(i, now.surface_id); });
+            attribute(now.parent_symbol_id != before.parent_symbol_id, [&](u8 i) { packet.set_parent_symbol_id(i, now.parent_symbol_id); });
+            attribute(now.layer != before.layer, [&](u8 i) { packet.set_layer(i, now.layer); });
+            attribute(u8(now.flash_duty_cycle_percentage) != u8(before.flash_duty_cycle_percentage), [&](u8 i) { packet.set_flash_duty_cycle_percentage(i, u8(now.flash_duty_cycle_percentage)); });
+            attribute(!same(now.flash_period, before.flash_period), [&](u8 i) { packet.set_flash_period(i, now.flash_period); });
+            attribute(!same(now.position_u, before.position_u), [&](u8 i) { packet.set_position_u(i, now.position_u); });
+            attribute(!same(now.position_v, before.position_v), [&](u8 i) { packet.set_position_v(i, now.position_v); });
+            attribute(!same(now.rotation, before.rotation), [&](u8 i) { packet.set_rotation(i, now.rotation); });
+            attribute(now.red != before.red || now.green != before.green || now.blue != before.blue || now.alpha != before.alpha, [&](u8 i) { packet.set_color(i, now.red, now.blue, now.green, now.alpha); });
+            attribute(!same(now.scale_u, before.scale_u), [&](u8 i) { packet.set_scale_u(i, now.scale_u); });
+            attribute(!same(now.scale_v, before.scale_v), [&](u8 i) { packet.set_scale_v(i, now.scale_v); });
+            if (count > 2)
+            {
+                return false;
+            }
+
+            session.write(packet);
+            ++shortened;
+            return true;
+        };
+
+        static auto part_key(u16 entity_id, u8 part_id) noexcept -> u64
+        {
+            return u64(entity_id) << 8 | part_id;
+        };
+        static auto component_key(component_control::component_class_t component_class, u16 instance_id, u16 component_id) noexcept -> u64
+        {
+            return u64(component_class) << 32 | u64(instance_id) << 16 | component_id;
+        };
+
+        auto forget(const std::unordered_set<u16>& ids) -> void
+        {
+            constexpr u64 entity_class = u64(component_control::component_class_t::entity);
+            entities.erase_if([&](u64 key) { return ids.contains(u16(key)); });
+            parts.erase_if([&](u64 key) { return ids.contains(u16(key >> 8)); });
+            components.erase_if([&](u64 key) { return key >> 32 == entity_class && ids.contains(u16(key >> 16)); });
+        };
+
+        u32 interval;
+        u32 frame = 0;
+        bool shorten = true;
+        std::size_t shortened = 0;
+        mirror_table<entity_control> entities;
+        mirror_table<articulated_part_control> parts;
+        mirror_table<component_control> components;
+        mirror_table<symbol_control> symbols;
+        // by entity id, during an emit. ordered, so what's left over goes
+        // out in a repeatable order.
+        std::map<u16, part_dof> unpaired;
+        // entities and symbols to forget after the next emit.
+        std::unordered_set<u16> destroyed;
+        std::unordered_set<u16> destroyed_symbols;
+    };
+};
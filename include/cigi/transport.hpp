@@ -0,0 +1,53 @@
+#pragma once
+
+#include "socket.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+
+namespace cigi
+{
+    // what a session sends datagrams through and receives them from, in
+    // place of its sockets: a shared_memory_channel, a loopback_link end, or
+    // one of a user's own. see session_network::connect.
+    struct transport
+    {
+        virtual ~transport() = default;
+
+        // sends the packets, in order, as datagrams split only between
+        // packets. returns the number of datagrams.
+        virtual auto send_packets(std::span<const std::span<const std::byte>> packets) -> std::size_t = 0;
+        // waits for up to timeout for a datagram. true if one is waiting.
+        virtual auto wait(std::chrono::microseconds timeout) -> bool = 0;
+        // the datagrams waiting, up to batch_size. the spans are valid, and
+        // may be written to, until the next read_batch.
+        virtual auto read_batch() -> std::span<const received_datagram> = 0;
+        [[nodiscard]]
+        virtual auto batch_size() const -> std::size_t = 0;
+        // largest datagram send_packets builds, in bytes.
+        [[nodiscard]]
+        virtual auto mtu() const -> std::size_t = 0;
+    };
+
+    // calls send(group, size) for each run of consecutive packets whose
+    // total size is at most max_size, in order, as a transport splits them
+    // into datagrams. a packet longer than max_size is a group of its own.
+    template <typename F>
+    auto for_each_datagram(std::span<const std::span<const std::byte>> packets, std::size_t max_size, F&& send) -> void
+    {
+        std::size_t i = 0;
+        while (i < packets.size())
+        {
+            std::size_t end = i;
+            std::size_t size = 0;
+            do
+            {
+                size += packets[end++].size();
+            } while (end < packets.size() && size + packets[end].size() <= max_size);
+
+            send(packets.subspan(i, end - i), size);
+            i = end;
+        }
+    };
+};
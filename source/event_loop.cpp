@@ -0,0 +1,189 @@
+#include "event_loop.hpp"
+
+#if defined(__linux__)
+#   include <sys/epoll.h>
+#   include <unistd.h>
+#elif defined(_WIN32)
+#   include <WinSock2.h>
+#else
+#   include <sys/select.h>
+#endif
+
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+    // timeout, shortened to the earliest await deadline of any session.
+    auto wait_time(std::span<cigi::session_network* const> sessions, std::chrono::microseconds timeout) -> std::chrono::microseconds
+    {
+        auto now = cigi::wait_clock::now();
+        for (auto* session : sessions)
+        {
+            if (!session->waiters.empty())
+            {
+                auto until = std::chrono::ceil<std::chrono::microseconds>(session->waiters.next_deadline() - now);
+                timeout = std::clamp(until, std::chrono::microseconds{ 0 }, timeout);
+            }
+        }
+        return timeout;
+    };
+
+    auto expire_waits(std::span<cigi::session_network* const> sessions) -> void
+    {
+        auto now = cigi::wait_clock::now();
+        for (auto* session : sessions)
+        {
+            if (!session->waiters.empty())
+            {
+                session->expire_waits(now);
+            }
+        }
+    };
+};
+
+namespace cigi
+{
+    struct event_loop::event_loop_impl
+    {
+        std::vector<session_network*> sessions = {};
+    #if defined(__linux__)
+        int epoll = -1;
+        std::vector<epoll_event> events = {};
+
+        event_loop_impl()
+        {
+            epoll = ::epoll_create1(EPOLL_CLOEXEC);
+            if (epoll < 0)
+            {
+                std::cout << "event_loop: Failed epoll_create1.\n";
+            }
+        };
+        ~event_loop_impl()
+        {
+            if (epoll >= 0)
+            {
+                ::close(epoll);
+            }
+        };
+
+        auto watch(session_network& session) -> bool
+        {
+            // edge-triggered: one event per arrival, so a ready session must
+            // be drained until its socket would block.
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLET;
+            event.data.ptr = &session;
+            return epoll >= 0 && ::epoll_ctl(epoll, EPOLL_CTL_ADD, int(session.receive.native_handle()), &event) == 0;
+        };
+        auto unwatch(session_network& session) -> void
+        {
+            ::epoll_ctl(epoll, EPOLL_CTL_DEL, int(session.receive.native_handle()), nullptr);
+        };
+        auto wait(std::chrono::microseconds timeout) -> std::size_t
+        {
+            events.resize(std::max<std::size_t>(sessions.size(), 1));
+            int milliseconds = int(std::chrono::ceil<std::chrono::milliseconds>(timeout).count());
+            int ready = ::epoll_wait(epoll, events.data(), int(events.size()), milliseconds);
+
+            std::size_t count = 0;
+            for (int i = 0; i < ready; ++i)
+            {
+                count += static_cast<session_network*>(events[i].data.ptr)->drain();
+            }
+            return count;
+        };
+    #else
+        auto watch(session_network&) -> bool
+        {
+            return sessions.size() < FD_SETSIZE;
+        };
+        auto unwatch(session_network&) -> void {};
+        auto wait(std::chrono::microseconds timeout) -> std::size_t
+        {
+            if (sessions.empty())
+            {
+                return 0;
+            }
+
+            fd_set readable;
+            FD_ZERO(&readable);
+            std::intptr_t highest = 0;
+            for (auto* session : sessions)
+            {
+                std::intptr_t socket = session->receive.native_handle();
+                FD_SET(socket, &readable);
+                highest = std::max(highest, socket);
+            }
+
+            timeval time;
+            time.tv_sec = long(timeout.count() / 1'000'000);
+            time.tv_usec = long(timeout.count() % 1'000'000);
+            if (::select(int(highest + 1), &readable, nullptr, nullptr, &time) <= 0)
+            {
+                return 0;
+            }
+
+            std::size_t count = 0;
+            for (auto* session : sessions)
+            {
+                if (FD_ISSET(session->receive.native_handle(), &readable))
+                {
+                    count += session->drain();
+                }
+            }
+            return count;
+        };
+    #endif
+    };
+
+    event_loop::event_loop() :
+        impl{ new event_loop_impl }
+    {};
+    event_loop::~event_loop() = default;
+
+    auto event_loop::add(session_network& session) -> bool
+    {
+        if (session.receive.native_handle() < 0 || std::ranges::find(impl->sessions, &session) != impl->sessions.end())
+        {
+            return false;
+        }
+        if (!session.receive.set_blocking(false) || !impl->watch(session))
+        {
+            session.receive.set_blocking(true);
+            return false;
+        }
+
+        impl->sessions.push_back(&session);
+        return true;
+    };
+    auto event_loop::remove(session_network& session) -> void
+    {
+        if (auto it = std::ranges::find(impl->sessions, &session); it != impl->sessions.end())
+        {
+            impl->unwatch(session);
+            session.receive.set_blocking(true);
+            impl->sessions.erase(it);
+        }
+    };
+    auto event_loop::size() const -> std::size_t
+    {
+        return impl->sessions.size();
+    };
+
+    auto event_loop::run_once(std::chrono::microseconds timeout) -> std::size_t
+    {
+        std::size_t count = impl->wait(wait_time(impl->sessions, timeout));
+        expire_waits(impl->sessions);
+        return count;
+    };
+    auto event_loop::run(std::stop_token stop) -> void
+    {
+        using namespace std::chrono_literals;
+        while (!stop.stop_requested())
+        {
+            // bounded, so a stop request is seen promptly.
+            run_once(10'000us);
+        }
+    };
+};
@@ -0,0 +1,457 @@
+#include "shared_memory.hpp"
+
+#ifdef __linux__
+#   include <linux/futex.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <sys/syscall.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <errno.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::uint32_t region_magic = 0x43494749; // "CIGI"
+    constexpr std::uint32_t region_version = 1;
+    constexpr std::size_t cache_line = 64;
+    // no CIGI packet is longer than this, so no slot may be shorter.
+    constexpr std::size_t min_slot_size = 256;
+    // datagram_index records packet offsets in 16 bits, so no slot may be
+    // longer than this.
+    constexpr std::size_t max_slot_size = 65535;
+    // checks for a datagram before sleeping: waking a sleeper costs both
+    // sides a syscall, and a peer mid-frame usually sends again sooner.
+    constexpr int spin_checks = 4096;
+
+    // the start of the region. the creator sets ready last, once the rest
+    // is initialized.
+    struct region_header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t slots;
+        std::uint32_t slot_size;
+        std::atomic<std::uint32_t> ready;
+    };
+
+    // one direction's indices, each side's on its own cache line. the
+    // receiver sets sleeping before waiting on signal, which the sender bumps
+    // after every batch.
+    struct ring_control
+    {
+        alignas(cache_line) std::atomic<std::uint64_t> write;
+        alignas(cache_line) std::atomic<std::uint64_t> read;
+        alignas(cache_line) std::atomic<std::uint32_t> signal;
+        std::atomic<std::uint32_t> sleeping;
+    };
+
+    struct slot_meta
+    {
+        std::uint32_t size;
+        std::int64_t sent_at;
+    };
+
+    // region_header, then both ring_controls, then both rings' slot_metas,
+    // then both rings' slots.
+    struct region_layout
+    {
+        std::size_t control = 0;
+        std::size_t meta = 0;
+        std::size_t data = 0;
+        std::size_t size = 0;
+
+        region_layout(std::size_t slots, std::size_t slot_size)
+        {
+            auto align = [](std::size_t offset) { return (offset + cache_line - 1) / cache_line * cache_line; };
+            control = align(sizeof(region_header));
+            meta = align(control + 2 * sizeof(ring_control));
+            data = align(meta + 2 * slots * sizeof(slot_meta));
+            size = data + 2 * slots * slot_size;
+        };
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free, "the shared rings need address-free atomics");
+};
+
+namespace cigi
+{
+#ifdef __linux__
+    struct shared_memory_channel::shared_memory_channel_impl
+    {
+        struct ring
+        {
+            ring_control* control = nullptr;
+            slot_meta* meta = nullptr;
+            std::byte* data = nullptr;
+        };
+
+        std::string name = {};
+        bool creator = false;
+        void* region = nullptr;
+        std::size_t region_size = 0;
+        std::size_t slots = 0;
+        std::size_t slot_size = 0;
+        ring tx = {};
+        ring rx = {};
+
+        // sender's side.
+        std::uint64_t write_index = 0;
+        std::uint64_t read_cache = 0;
+        std::uint64_t overrun_count = 0;
+        std::uint64_t sent_count = 0;
+
+        // receiver's side: datagrams from read_index on are read, but the
+        // held ones are still in use until the next read_batch.
+        std::uint64_t read_index = 0;
+        std::size_t held = 0;
+        std::vector<received_datagram> batch = {};
+
+        ~shared_memory_channel_impl()
+        {
+            close();
+        };
+
+        auto open(std::string_view name, shared_memory_role role, std::size_t slots, std::size_t slot_size) -> bool
+        {
+            close();
+            this->name = std::string{ name };
+
+            int fd = ::shm_open(this->name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+            creator = fd >= 0;
+            if (creator)
+            {
+                this->slots = std::bit_ceil(std::max<std::size_t>(slots, 2));
+                this->slot_size = std::clamp(slot_size, min_slot_size, max_slot_size);
+                region_size = region_layout{ this->slots, this->slot_size }.size;
+                if (::ftruncate(fd, off_t(region_size)) < 0 || !map(fd))
+                {
+                    std::cout << "shared_memory_channel: Failed to create " << name << ".\n";
+                    ::close(fd);
+                    ::shm_unlink(this->name.c_str());
+                    creator = false;
+                    return false;
+                }
+                ::close(fd);
+                initialize();
+            }
+            else
+            {
+                fd = errno == EEXIST ? ::shm_open(this->name.c_str(), O_RDWR | O_CLOEXEC, 0600) : -1;
+                bool mapped = fd >= 0 && attach(fd);
+                if (fd >= 0)
+                {
+                    ::close(fd);
+                }
+                if (!mapped)
+                {
+                    std::cout << "shared_memory_channel: Failed to open " << name << ".\n";
+                    close();
+                    return false;
+                }
+            }
+
+            region_layout layout{ this->slots, this->slot_size };
+            auto* base = static_cast<std::byte*>(region);
+            auto* controls = reinterpret_cast<ring_control*>(base + layout.control);
+            auto* metas = reinterpret_cast<slot_meta*>(base + layout.meta);
+            auto ring_at = [&](std::size_t i) { return ring{ &controls[i], metas + i * this->slots, base + layout.data + i * this->slots * this->slot_size }; };
+            tx = ring_at(role == shared_memory_role::host ? 0 : 1);
+            rx = ring_at(role == shared_memory_role::host ? 1 : 0);
+
+            // picks up where an earlier session on this region left off.
+            write_index = tx.control->write.load(std::memory_order_relaxed);
+            read_cache = tx.control->read.load(std::memory_order_acquire);
+            read_index = rx.control->read.load(std::memory_order_relaxed);
+            held = 0;
+            batch.reserve(this->slots);
+            return true;
+        };
+        auto close() -> void
+        {
+            if (region != nullptr)
+            {
+                release_held();
+                ::munmap(region, region_size);
+                region = nullptr;
+            }
+            if (creator)
+            {
+                ::shm_unlink(name.c_str());
+                creator = false;
+            }
+            tx = {};
+            rx = {};
+            batch.clear();
+        };
+        auto map(int fd) -> bool
+        {
+            void* memory = ::mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (memory == MAP_FAILED)
+            {
+                return false;
+            }
+            region = memory;
+            return true;
+        };
+        auto initialize() -> void
+        {
+            region_layout layout{ slots, slot_size };
+            auto* base = static_cast<std::byte*>(region);
+            for (std::size_t i = 0; i < 2; ++i)
+            {
+                new (base + layout.control + i * sizeof(ring_control)) ring_control{};
+            }
+
+            auto* header = new (region) region_header{ region_magic, region_version, std::uint32_t(slots), std::uint32_t(slot_size), 0 };
+            header->ready.store(region_magic, std::memory_order_release);
+        };
+        // maps a region another process created, waiting briefly for it to
+        // finish setting it up.
+        auto attach(int fd) -> bool
+        {
+            using namespace std::chrono_literals;
+            auto deadline = std::chrono::steady_clock::now() + 1s;
+            struct stat status{};
+            while (::fstat(fd, &status) == 0 && std::size_t(status.st_size) < sizeof(region_header))
+            {
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    return false;
+                }
+                std::this_thread::sleep_for(100us);
+            }
+            region_size = std::size_t(status.st_size);
+            if (region_size < sizeof(region_header) || !map(fd))
+            {
+                return false;
+            }
+
+            auto* header = static_cast<region_header*>(region);
+            while (header->ready.load(std::memory_order_acquire) != region_magic)
+            {
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    return false;
+                }
+                std::this_thread::sleep_for(100us);
+            }
+            slots = header->slots;
+            slot_size = header->slot_size;
+            return header->magic == region_magic && header->version == region_version && std::has_single_bit(slots) && slot_size >= min_slot_size && slot_size <= max_slot_size && region_layout{ slots, slot_size }.size <= region_size;
+        };
+
+        auto send_packets(std::span<const std::span<const std::byte>> packets) -> std::size_t
+        {
+            if (region == nullptr)
+            {
+                return 0;
+            }
+
+            std::int64_t now = std::chrono::system_clock::now().time_since_epoch().count();
+            std::uint64_t first = write_index;
+            for_each_datagram(packets, slot_size, [&](std::span<const std::span<const std::byte>> group, std::size_t size)
+            {
+                if (size > slot_size)
+                {
+                    std::cout << "shared_memory_channel: Dropped a packet longer than a slot.\n";
+                    return;
+                }
+                if (write_index - read_cache == slots)
+                {
+                    read_cache = tx.control->read.load(std::memory_order_acquire);
+                    if (write_index - read_cache == slots)
+                    {
+                        ++overrun_count;
+                        return;
+                    }
+                }
+
+                std::size_t slot = write_index & (slots - 1);
+                std::byte* out = tx.data + slot * slot_size;
+                for (const auto& packet : group)
+                {
+                    std::memcpy(out, packet.data(), packet.size());
+                    out += packet.size();
+                }
+                tx.meta[slot] = { std::uint32_t(size), now };
+                ++write_index;
+            });
+
+            std::size_t sent = std::size_t(write_index - first);
+            if (sent != 0)
+            {
+                // published once for the whole batch. the seq_cst order with
+                // the receiver's sleeping and signal means either it sees the
+                // new index or this sees it asleep.
+                tx.control->write.store(write_index, std::memory_order_release);
+                tx.control->signal.fetch_add(1, std::memory_order_seq_cst);
+                if (tx.control->sleeping.load(std::memory_order_seq_cst) != 0)
+                {
+                    ::syscall(SYS_futex, &tx.control->signal, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+                }
+                sent_count += sent;
+            }
+            return sent;
+        };
+
+        [[nodiscard]]
+        auto available() const noexcept -> bool
+        {
+            return rx.control->write.load(std::memory_order_acquire) != read_index + held;
+        };
+        auto wait(std::chrono::microseconds timeout) -> bool
+        {
+            if (region == nullptr)
+            {
+                return false;
+            }
+            for (int i = 0; i < spin_checks; ++i)
+            {
+                if (available())
+                {
+                    return true;
+                }
+            }
+
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            while (true)
+            {
+                auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now());
+                if (remaining.count() <= 0)
+                {
+                    return available();
+                }
+
+                rx.control->sleeping.store(1, std::memory_order_seq_cst);
+                std::uint32_t signal = rx.control->signal.load(std::memory_order_seq_cst);
+                if (!available())
+                {
+                    timespec time{ .tv_sec = time_t(remaining.count() / 1'000'000'000), .tv_nsec = long(remaining.count() % 1'000'000'000) };
+                    ::syscall(SYS_futex, &rx.control->signal, FUTEX_WAIT, signal, &time, nullptr, 0);
+                }
+                rx.control->sleeping.store(0, std::memory_order_relaxed);
+                if (available())
+                {
+                    return true;
+                }
+            }
+        };
+        auto release_held() -> void
+        {
+            if (held != 0)
+            {
+                read_index += held;
+                held = 0;
+                rx.control->read.store(read_index, std::memory_order_release);
+            }
+        };
+        auto read_batch() -> std::span<const received_datagram>
+        {
+            batch.clear();
+            if (region == nullptr)
+            {
+                return {};
+            }
+
+            release_held();
+            std::uint64_t write = rx.control->write.load(std::memory_order_acquire);
+            held = std::size_t(std::min<std::uint64_t>(write - read_index, slots));
+            for (std::size_t i = 0; i < held; ++i)
+            {
+                std::size_t slot = (read_index + i) & (slots - 1);
+                const slot_meta& meta = rx.meta[slot];
+                received_datagram datagram;
+                datagram.bytes = { rx.data + slot * slot_size, std::min<std::size_t>(meta.size, slot_size) };
+                datagram.received_at = std::chrono::system_clock::time_point{ std::chrono::system_clock::duration{ meta.sent_at } };
+                batch.push_back(datagram);
+            }
+            return batch;
+        };
+    };
+#else
+    struct shared_memory_channel::shared_memory_channel_impl
+    {
+        std::size_t slots = 0;
+        std::size_t slot_size = 0;
+        std::uint64_t overrun_count = 0;
+        std::uint64_t sent_count = 0;
+        void* region = nullptr;
+
+        auto open(std::string_view, shared_memory_role, std::size_t, std::size_t) -> bool
+        {
+            std::cout << "shared_memory_channel: Not supported on this platform.\n";
+            return false;
+        };
+        auto close() -> void {};
+        auto send_packets(std::span<const std::span<const std::byte>>) -> std::size_t
+        {
+            return 0;
+        };
+        auto wait(std::chrono::microseconds) -> bool
+        {
+            return false;
+        };
+        auto read_batch() -> std::span<const received_datagram>
+        {
+            return {};
+        };
+    };
+#endif
+
+    shared_memory_channel::shared_memory_channel() :
+        impl{ new shared_memory_channel_impl }
+    {};
+    shared_memory_channel::~shared_memory_channel() = default;
+
+    auto shared_memory_channel::open(std::string_view name, shared_memory_role role, std::size_t slots, std::size_t slot_size) -> bool
+    {
+        return impl->open(name, role, slots, slot_size);
+    };
+    auto shared_memory_channel::close() -> void
+    {
+        impl->close();
+    };
+    auto shared_memory_channel::is_open() const -> bool
+    {
+        return impl->region != nullptr;
+    };
+    auto shared_memory_channel::send_packets(std::span<const std::span<const std::byte>> packets) -> std::size_t
+    {
+        return impl->send_packets(packets);
+    };
+    auto shared_memory_channel::wait(std::chrono::microseconds timeout) -> bool
+    {
+        return impl->wait(timeout);
+    };
+    auto shared_memory_channel::read_batch() -> std::span<const received_datagram>
+    {
+        return impl->read_batch();
+    };
+    auto shared_memory_channel::batch_size() const -> std::size_t
+    {
+        return impl->slots;
+    };
+    auto shared_memory_channel::mtu() const -> std::size_t
+    {
+        return impl->slot_size;
+    };
+    auto shared_memory_channel::overruns() const -> std::uint64_t
+    {
+        return impl->overrun_count;
+    };
+    auto shared_memory_channel::packets_sent() const -> std::uint64_t
+    {
+        return impl->sent_count;
+    };
+};
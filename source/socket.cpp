@@ -13,6 +13,7 @@
 #   include <arpa/inet.h>
 #   include <netdb.h>
 #   include <unistd.h>
+#   include <fcntl.h>
 #   include <errno.h>
 #   include <cstring>
 #   include <atomic>
@@ -22,11 +23,16 @@ using SOCKET = int;
 constexpr int INVALID_SOCKET = -1;
 #endif
 
+#include "uring.hpp"
+
+#include <algorithm>
+#include <bit>
 #include <iostream>
 
 namespace
 {
-    constexpr std::size_t mtu_size = 1432;
+    // most buffers one sendmsg takes (IOV_MAX on linux).
+    constexpr std::size_t max_gather = 1024;
 
     struct socket_initializer
     {
@@ -84,6 +90,127 @@ namespace
         return result;
     };
 
+    auto set_non_blocking(SOCKET socket, bool non_blocking) -> bool
+    {
+    #ifdef _WIN32
+        u_long value = non_blocking ? 1 : 0;
+        return IOCTL_SOCKET(socket, FIONBIO, &value) == 0;
+    #else
+        int flags = ::fcntl(socket, F_GETFL, 0);
+        if (flags < 0)
+        {
+            return false;
+        }
+        flags = non_blocking ? flags | O_NONBLOCK : flags & ~O_NONBLOCK;
+        return ::fcntl(socket, F_SETFL, flags) == 0;
+    #endif
+    };
+
+    template <typename T>
+    auto set_option(SOCKET socket, int level, int name, T value) -> cigi::option_result
+    {
+        return ::setsockopt(socket, level, name, (const char*)&value, sizeof(value)) == 0 ? cigi::option_result::honored : cigi::option_result::rejected;
+    };
+    auto get_int_option(SOCKET socket, int level, int name) -> int
+    {
+        int value = 0;
+        socklen_t size = sizeof(value);
+        return ::getsockopt(socket, level, name, (char*)&value, &size) == 0 ? value : 0;
+    };
+    // a buffer size is honored if what's read back is at least what was
+    // asked for.
+    auto set_buffer_size(SOCKET socket, int name, [[maybe_unused]] int force_name, int size) -> cigi::option_result
+    {
+        ::setsockopt(socket, SOL_SOCKET, name, (const char*)&size, sizeof(size));
+    #ifdef __linux__
+        if (get_int_option(socket, SOL_SOCKET, name) < size)
+        {
+            ::setsockopt(socket, SOL_SOCKET, force_name, (const char*)&size, sizeof(size));
+        }
+    #endif
+        return get_int_option(socket, SOL_SOCKET, name) >= size ? cigi::option_result::honored : cigi::option_result::rejected;
+    };
+
+    auto apply_options(SOCKET socket, const cigi::socket_options& options) -> cigi::socket_options_result
+    {
+        using cigi::option_result;
+        cigi::socket_options_result result;
+        if (socket == INVALID_SOCKET)
+        {
+            return result;
+        }
+
+    #ifdef __linux__
+        constexpr int receive_buffer_force = SO_RCVBUFFORCE;
+        constexpr int send_buffer_force = SO_SNDBUFFORCE;
+    #else
+        constexpr int receive_buffer_force = 0;
+        constexpr int send_buffer_force = 0;
+    #endif
+        if (options.receive_buffer)
+        {
+            result.receive_buffer = set_buffer_size(socket, SO_RCVBUF, receive_buffer_force, *options.receive_buffer);
+        }
+        if (options.send_buffer)
+        {
+            result.send_buffer = set_buffer_size(socket, SO_SNDBUF, send_buffer_force, *options.send_buffer);
+        }
+        result.receive_buffer_size = get_int_option(socket, SOL_SOCKET, SO_RCVBUF);
+        result.send_buffer_size = get_int_option(socket, SOL_SOCKET, SO_SNDBUF);
+
+    #ifdef __linux__
+        if (options.busy_poll)
+        {
+            result.busy_poll = set_option(socket, SOL_SOCKET, SO_BUSY_POLL, *options.busy_poll);
+        }
+        if (options.priority)
+        {
+            result.priority = set_option(socket, SOL_SOCKET, SO_PRIORITY, *options.priority);
+        }
+    #else
+        result.busy_poll = options.busy_poll ? option_result::rejected : option_result::unset;
+        result.priority = options.priority ? option_result::rejected : option_result::unset;
+    #endif
+        if (options.dscp)
+        {
+            result.dscp = *options.dscp < 64 ? set_option(socket, IPPROTO_IP, IP_TOS, int(*options.dscp) << 2) : option_result::rejected;
+        }
+        if (options.multicast_ttl)
+        {
+            result.multicast_ttl = set_option(socket, IPPROTO_IP, IP_MULTICAST_TTL, *options.multicast_ttl);
+        }
+        if (options.multicast_loop)
+        {
+            result.multicast_loop = set_option(socket, IPPROTO_IP, IP_MULTICAST_LOOP, int(*options.multicast_loop));
+        }
+        if (options.non_blocking)
+        {
+            result.non_blocking = set_non_blocking(socket, true) ? option_result::honored : option_result::rejected;
+        }
+        return result;
+    };
+
+#ifdef __linux__
+    // room for the one control message asked for, a SO_TIMESTAMPNS stamp.
+    constexpr std::size_t timestamp_control_size = CMSG_SPACE(sizeof(timespec));
+
+    // the kernel's receive time in a message's control data, or zero.
+    auto control_timestamp(const msghdr& message) -> std::chrono::system_clock::time_point
+    {
+        for (const cmsghdr* control = CMSG_FIRSTHDR(&message); control != nullptr; control = CMSG_NXTHDR(const_cast<msghdr*>(&message), const_cast<cmsghdr*>(control)))
+        {
+            if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS)
+            {
+                timespec time;
+                std::memcpy(&time, CMSG_DATA(control), sizeof(time));
+                auto since_epoch = std::chrono::seconds{ time.tv_sec } + std::chrono::nanoseconds{ time.tv_nsec };
+                return std::chrono::system_clock::time_point{ std::chrono::duration_cast<std::chrono::system_clock::duration>(since_epoch) };
+            }
+        }
+        return {};
+    };
+#endif
+
     auto is_multicast(const std::string& address, std::uint32_t& ipv4) -> bool
     {
         if (!to_ipv4(address, ipv4))
@@ -98,14 +225,59 @@ namespace
 
 namespace cigi
 {
+    auto io_uring_available() -> bool
+    {
+    #ifdef __linux__
+        static const bool available = []
+        {
+            detail::uring probe;
+            return probe.open(2, false);
+        }();
+        return available;
+    #else
+        return false;
+    #endif
+    };
+
     struct send_socket::send_socket_impl
     {
         SOCKET                  socket = INVALID_SOCKET;
+        std::size_t             mtu = default_mtu;
         std::vector<std::byte>  cache = {};
         std::atomic_uint64_t    packets_sent = 0;
         std::atomic_uint64_t    bytes_sent = 0;
 
-        auto connect(std::string_view ip, std::uint16_t port) -> void
+        // reused by send_packets: the first packet and packet count of each
+        // datagram, and the buffers and headers handed to the kernel.
+        std::vector<std::pair<std::size_t, std::size_t>> datagrams = {};
+    #ifdef __linux__
+        std::vector<iovec>      gather = {};
+        std::vector<mmsghdr>    headers = {};
+        detail::uring           uring = {};
+    #endif
+        socket_backend          backend = socket_backend::bsd;
+
+        auto set_backend(socket_backend requested) -> socket_backend
+        {
+        #ifdef __linux__
+            if (requested != socket_backend::bsd && uring.valid() && uring.kernel_polling() == (requested == socket_backend::io_uring_polled))
+            {
+                backend = requested;
+                return backend;
+            }
+        #endif
+            backend = socket_backend::bsd;
+        #ifdef __linux__
+            uring.close();
+            if (requested != socket_backend::bsd && uring.open(256, requested == socket_backend::io_uring_polled))
+            {
+                backend = requested;
+            }
+        #endif
+            return backend;
+        };
+
+        auto connect(std::string_view ip, std::uint16_t port, const socket_options& options) -> socket_options_result
         {
             initialize_sockets();
             socket = ::socket(AF_INET, SOCK_DGRAM, 0);
@@ -115,6 +287,7 @@ namespace cigi
             {
                 std::cout << "send_socket: Failed to set SO_REUSEADDR.\n";
             }
+            socket_options_result result = apply_options(socket, options);
 
             sockaddr_in socket_address{ 0 };
             socket_address.sin_family = AF_INET;
@@ -131,19 +304,21 @@ namespace cigi
             {
                 std::cout << "send_socket: Failed to connect to " << ip << ":" << port << ".\n";
             }
+            return result;
         };
         auto disconnect() -> void
         {
             if (socket != INVALID_SOCKET)
             {
                 CLOSE_SOCKET(socket);
+                socket = INVALID_SOCKET;
             }
         };
         auto send_bytes(std::span<std::byte> bytes) -> void
         {
             std::size_t cached_size = cache.size();
             std::size_t new_cache_size = cached_size + bytes.size();
-            if (new_cache_size < mtu_size)
+            if (new_cache_size < mtu)
             {
                 cache.resize(new_cache_size);
                 std::copy(bytes.data(), bytes.data() + bytes.size(), cache.data() + cached_size);
@@ -172,6 +347,164 @@ namespace cigi
 
             cache.clear();
         };
+        auto send_packets(std::span<const std::span<const std::byte>> packets) -> std::size_t
+        {
+            // anything sent with send_bytes goes first.
+            flush();
+
+            // split at packet boundaries, so no packet straddles datagrams.
+            datagrams.clear();
+            std::size_t datagram_size = 0;
+            std::size_t total_size = 0;
+            for (std::size_t i = 0; i < packets.size(); ++i)
+            {
+                std::size_t size = packets[i].size();
+                if (datagrams.empty() || datagram_size + size > mtu || datagrams.back().second == max_gather)
+                {
+                    datagrams.emplace_back(i, 0);
+                    datagram_size = 0;
+                }
+                ++datagrams.back().second;
+                datagram_size += size;
+                total_size += size;
+            }
+            if (datagrams.empty())
+            {
+                return 0;
+            }
+
+            // only what the kernel took is counted.
+            std::size_t sent = 0;
+            std::size_t sent_size = 0;
+            if (socket != INVALID_SOCKET)
+            {
+            #ifdef __linux__
+                // the kernel reads the packets where they are, and the whole
+                // frame is one call unless it's more than max_gather datagrams.
+                gather.resize(packets.size());
+                for (std::size_t i = 0; i < packets.size(); ++i)
+                {
+                    gather[i] = { (void*)packets[i].data(), packets[i].size() };
+                }
+                headers.assign(datagrams.size(), mmsghdr{});
+                for (std::size_t i = 0; i < datagrams.size(); ++i)
+                {
+                    headers[i].msg_hdr.msg_iov = gather.data() + datagrams[i].first;
+                    headers[i].msg_hdr.msg_iovlen = datagrams[i].second;
+                }
+
+                sent = backend != socket_backend::bsd ? send_uring() : 0;
+                while (sent < headers.size())
+                {
+                    int count = ::sendmmsg(socket, headers.data() + sent, unsigned(std::min(headers.size() - sent, max_gather)), 0);
+                    if (count <= 0)
+                    {
+                        std::cout << "send_socket: Failed sendmmsg.\n";
+                        break;
+                    }
+                    sent += std::size_t(count);
+                }
+                for (std::size_t i = 0; i < sent; ++i)
+                {
+                    sent_size += headers[i].msg_len;
+                }
+            #else
+                for (auto [first, count] : datagrams)
+                {
+                    for (const auto& packet : packets.subspan(first, count))
+                    {
+                        cache.insert(cache.end(), packet.begin(), packet.end());
+                    }
+                    int bytes = ::send(socket, (char*)cache.data(), int(cache.size()), 0);
+                    cache.clear();
+                    if (bytes < 0)
+                    {
+                        std::cout << "send_socket: Failed send.\n";
+                        break;
+                    }
+                    ++sent;
+                    sent_size += std::size_t(bytes);
+                }
+            #endif
+            }
+
+            packets_sent.fetch_add(sent);
+            bytes_sent.fetch_add(sent_size);
+            return sent;
+        };
+    #ifdef __linux__
+        // one sendmsg submission per datagram, all submitted and waited for
+        // with a single io_uring_enter. the submissions are linked, so they
+        // run in order and a failed one cancels the rest, which sendmmsg then
+        // sends. returns the datagrams sent, a prefix of headers.
+        auto send_uring() -> std::size_t
+        {
+            std::size_t sent = 0;
+            while (sent < headers.size())
+            {
+                unsigned submitted = 0;
+                io_uring_sqe* last = nullptr;
+                while (sent + submitted < headers.size())
+                {
+                    io_uring_sqe* sqe = uring.get_sqe();
+                    if (sqe == nullptr)
+                    {
+                        break;
+                    }
+                    sqe->opcode = IORING_OP_SENDMSG;
+                    sqe->fd = socket;
+                    sqe->addr = std::uint64_t(&headers[sent + submitted].msg_hdr);
+                    sqe->len = 1;
+                    sqe->flags = IOSQE_IO_LINK;
+                    sqe->user_data = sent + submitted;
+                    last = sqe;
+                    ++submitted;
+                }
+                if (submitted == 0)
+                {
+                    std::cout << "send_socket: Failed io_uring submission.\n";
+                    return sent;
+                }
+                // the chain ends with the submission.
+                last->flags = 0;
+                if (uring.submit(submitted) < 0)
+                {
+                    std::cout << "send_socket: Failed io_uring submission.\n";
+                    return sent;
+                }
+
+                // the packets mustn't be released before the kernel is done.
+                unsigned succeeded = 0;
+                for (unsigned completed = 0; completed < submitted;)
+                {
+                    if (io_uring_cqe* cqe = uring.peek(); cqe != nullptr)
+                    {
+                        if (cqe->res >= 0)
+                        {
+                            headers[cqe->user_data].msg_len = unsigned(cqe->res);
+                            ++succeeded;
+                        }
+                        else if (cqe->res != -ECANCELED)
+                        {
+                            std::cout << "send_socket: Failed io_uring sendmsg.\n";
+                        }
+                        uring.advance();
+                        ++completed;
+                    }
+                    else
+                    {
+                        uring.wait(std::chrono::microseconds{ -1 });
+                    }
+                }
+                sent += succeeded;
+                if (succeeded < submitted)
+                {
+                    return sent;
+                }
+            }
+            return sent;
+        };
+    #endif
     };
 
     send_socket::send_socket() :
@@ -181,10 +514,10 @@ namespace cigi
     {
         disconnect();
     };
-    auto send_socket::connect(std::string_view ip, std::uint16_t port) -> void
+    auto send_socket::connect(std::string_view ip, std::uint16_t port, const socket_options& options) -> socket_options_result
     {
         impl->disconnect();
-        impl->connect(ip, port);
+        return impl->connect(ip, port, options);
     };
     auto send_socket::disconnect() -> void
     {
@@ -198,6 +531,26 @@ namespace cigi
     {
         impl->flush();
     };
+    auto send_socket::send_packets(std::span<const std::span<const std::byte>> packets) -> std::size_t
+    {
+        return impl->send_packets(packets);
+    };
+    auto send_socket::set_backend(socket_backend backend) -> socket_backend
+    {
+        return impl->set_backend(backend);
+    };
+    auto send_socket::backend() const -> socket_backend
+    {
+        return impl->backend;
+    };
+    auto send_socket::set_mtu(std::size_t mtu) -> void
+    {
+        impl->mtu = std::max<std::size_t>(mtu, 2);
+    };
+    auto send_socket::mtu() const -> std::size_t
+    {
+        return impl->mtu;
+    };
     auto send_socket::packets_sent() const -> std::uint64_t
     {
         return impl->packets_sent;
@@ -211,7 +564,32 @@ namespace cigi
     {
         SOCKET socket = INVALID_SOCKET;
 
-        auto connect(std::string_view ip, std::uint16_t port, std::string_view device) -> void
+        // the batch pool, laid out once so a batch is a single call.
+        std::size_t                         batch_datagram_size = 0;
+        std::vector<std::byte>              batch_buffers = {};
+        std::vector<sockaddr_in>            batch_sources = {};
+        std::vector<received_datagram>      batch = {};
+    #ifdef __linux__
+        std::vector<iovec>                  batch_iovecs = {};
+        std::vector<mmsghdr>                batch_headers = {};
+        std::vector<std::byte>              batch_controls = {};
+
+        // the io_uring backend: one multishot recvmsg, kept armed, receiving
+        // into a ring of provided buffers. the buffers of a batch go back to
+        // the kernel when the next batch is read.
+        detail::uring                       uring = {};
+        detail::uring_buffer_ring           uring_buffers = {};
+        msghdr                              uring_message = {};
+        std::vector<std::uint16_t>          uring_held = {};
+        bool                                uring_armed = false;
+        bool                                uring_unsupported = false;
+    #endif
+        socket_backend                      requested_backend = socket_backend::bsd;
+        socket_backend                      backend = socket_backend::bsd;
+        bool                                blocking = true;
+        bool                                timestamps = false;
+
+        auto connect(std::string_view ip, std::uint16_t port, std::string_view device, const socket_options& options) -> socket_options_result
         {
             initialize_sockets();
             socket = ::socket(AF_INET, SOCK_DGRAM, 0);
@@ -221,6 +599,7 @@ namespace cigi
             {
                 std::cout << "receive_socket: Failed to set SO_REUSEADDR.\n";
             }
+            socket_options_result result = apply_options(socket, options);
 
             sockaddr_in socket_address{ 0 };
             socket_address.sin_family = AF_INET;
@@ -257,20 +636,36 @@ namespace cigi
                     std::cout << "receive_socket: Failed to set IP_ADD_MEMBERSHIP.\n";
                 }
             }
+
+            blocking = result.non_blocking != option_result::honored;
+            if (timestamps)
+            {
+                apply_timestamps();
+            }
+            start_backend();
+            return result;
         };
         auto disconnect() -> void
         {
+            stop_backend();
             if (socket != INVALID_SOCKET)
             {
                 CLOSE_SOCKET(socket);
+                socket = INVALID_SOCKET;
             }
         };
-        auto bytes_available() const -> int
+        auto bytes_available() -> int
         {
             if (socket == INVALID_SOCKET)
             {
                 return -1;
             }
+        #ifdef __linux__
+            if (backend != socket_backend::bsd)
+            {
+                return uring_bytes_available();
+            }
+        #endif
 
             u_long out;
             if (IOCTL_SOCKET(socket, FIONREAD, &out) < 0)
@@ -280,7 +675,7 @@ namespace cigi
 
             return int(out);
         };
-        auto read_bytes(int size, std::vector<std::byte>& data) const -> bool
+        auto read_bytes(int size, std::vector<std::byte>& data) -> bool
         {
             data.clear();
 
@@ -288,6 +683,17 @@ namespace cigi
             {
                 return false;
             }
+        #ifdef __linux__
+            if (backend != socket_backend::bsd)
+            {
+                auto one = read_uring(1);
+                if (!one.empty())
+                {
+                    data.assign(one[0].bytes.begin(), one[0].bytes.end());
+                }
+                return !one.empty();
+            }
+        #endif
 
             std::size_t bytes = 0;
             if (size <= 0)
@@ -313,18 +719,401 @@ namespace cigi
 
             return bytes > 0;
         };
-        auto select(std::chrono::microseconds timeout_us) const -> bool
+        auto read_into(std::span<std::byte> buffer) -> int
+        {
+            if (socket == INVALID_SOCKET)
+            {
+                return -1;
+            }
+        #ifdef __linux__
+            if (backend != socket_backend::bsd)
+            {
+                auto one = read_uring(1);
+                if (one.empty())
+                {
+                    return -1;
+                }
+                std::size_t size = std::min(one[0].bytes.size(), buffer.size());
+                std::memcpy(buffer.data(), one[0].bytes.data(), size);
+                return int(size);
+            }
+        #endif
+
+            return int(::recv(socket, (char*)buffer.data(), int(buffer.size()), 0));
+        };
+        auto select(std::chrono::microseconds timeout_us) -> bool
         {
-            fd_set sockets{ 0 };
+            if (socket == INVALID_SOCKET)
+            {
+                return false;
+            }
+        #ifdef __linux__
+            if (backend != socket_backend::bsd)
+            {
+                return uring.wait(timeout_us);
+            }
+        #endif
+
+            fd_set sockets;
+            FD_ZERO(&sockets);
             FD_SET(socket, &sockets);
 
             timeval timeout;
-            timeout.tv_sec = 0;
-            timeout.tv_usec = timeout_us.count();
+            timeout.tv_sec = long(timeout_us.count() / 1'000'000);
+            timeout.tv_usec = long(timeout_us.count() % 1'000'000);
 
-            int socket_count = ::select(socket + 1, &sockets, nullptr, nullptr, &timeout);
+            int socket_count = ::select(int(socket + 1), &sockets, nullptr, nullptr, &timeout);
             return socket_count > 0;
         };
+        auto reserve_batch(std::size_t count, std::size_t datagram_size) -> void
+        {
+            count = std::max<std::size_t>(count, 1);
+            batch_datagram_size = datagram_size;
+            batch_buffers.assign(count * datagram_size, std::byte{ 0 });
+            batch_sources.assign(count, sockaddr_in{});
+            batch.assign(count, received_datagram{});
+        #ifdef __linux__
+            batch_iovecs.resize(count);
+            batch_headers.assign(count, mmsghdr{});
+            batch_controls.assign(count * timestamp_control_size, std::byte{ 0 });
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                batch_iovecs[i] = { batch_buffers.data() + i * datagram_size, datagram_size };
+                auto& header = batch_headers[i].msg_hdr;
+                header.msg_name = &batch_sources[i];
+                header.msg_control = batch_controls.data() + i * timestamp_control_size;
+                header.msg_iov = &batch_iovecs[i];
+                header.msg_iovlen = 1;
+            }
+        #endif
+
+            // the provided buffers are sized from the pool.
+            if (backend != socket_backend::bsd)
+            {
+                start_backend();
+            }
+        };
+        auto read_batch() -> std::span<const received_datagram>
+        {
+            if (socket == INVALID_SOCKET)
+            {
+                return {};
+            }
+            if (batch.empty())
+            {
+                reserve_batch(default_batch_size, default_datagram_size);
+            }
+
+            std::size_t count = 0;
+        #ifdef __linux__
+            if (backend != socket_backend::bsd)
+            {
+                return read_uring(batch.size());
+            }
+
+            for (auto& header : batch_headers)
+            {
+                header.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                header.msg_hdr.msg_controllen = timestamps ? timestamp_control_size : 0;
+            }
+
+            // waits for the first datagram at most, then takes what's there.
+            int received = ::recvmmsg(socket, batch_headers.data(), unsigned(batch_headers.size()), MSG_WAITFORONE, nullptr);
+            count = received > 0 ? std::size_t(received) : 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto& header = batch_headers[i];
+                batch[i] = {
+                    .bytes = { batch_buffers.data() + i * batch_datagram_size, std::min<std::size_t>(header.msg_len, batch_datagram_size) },
+                    .source_address = ntohl(batch_sources[i].sin_addr.s_addr),
+                    .source_port = ntohs(batch_sources[i].sin_port),
+                    .truncated = (header.msg_hdr.msg_flags & MSG_TRUNC) != 0,
+                    .received_at = timestamps ? control_timestamp(header.msg_hdr) : std::chrono::system_clock::time_point{},
+                };
+            }
+        #else
+            for (; count < batch.size(); ++count)
+            {
+                if (count != 0 && bytes_available() <= 0)
+                {
+                    break;
+                }
+
+                std::byte* buffer = batch_buffers.data() + count * batch_datagram_size;
+                socklen_t address_size = sizeof(sockaddr_in);
+                int received = ::recvfrom(socket, (char*)buffer, int(batch_datagram_size), 0, (sockaddr*)&batch_sources[count], &address_size);
+                if (received < 0)
+                {
+                    break;
+                }
+                batch[count] = {
+                    .bytes = { buffer, std::size_t(received) },
+                    .source_address = ntohl(batch_sources[count].sin_addr.s_addr),
+                    .source_port = ntohs(batch_sources[count].sin_port),
+                };
+            }
+        #endif
+
+            return std::span{ batch }.first(count);
+        };
+        auto set_blocking(bool blocking) -> bool
+        {
+            if (socket == INVALID_SOCKET)
+            {
+                return false;
+            }
+            this->blocking = blocking;
+            return set_non_blocking(socket, !blocking);
+        };
+
+        auto set_timestamps(bool enable) -> bool
+        {
+            timestamps = enable;
+            if (socket == INVALID_SOCKET)
+            {
+                return false;
+            }
+
+            bool honored = apply_timestamps();
+            // the io_uring buffers make room for the stamps.
+            if (backend != socket_backend::bsd)
+            {
+                start_backend();
+            }
+            return honored;
+        };
+        // true if stamps are now on.
+        auto apply_timestamps() -> bool
+        {
+        #ifdef __linux__
+            int value = timestamps ? 1 : 0;
+            if (::setsockopt(socket, SOL_SOCKET, SO_TIMESTAMPNS, &value, sizeof(value)) < 0)
+            {
+                std::cout << "receive_socket: Failed to set SO_TIMESTAMPNS.\n";
+                timestamps = false;
+            }
+        #else
+            timestamps = false;
+        #endif
+            return timestamps;
+        };
+        auto set_backend(socket_backend requested) -> socket_backend
+        {
+            requested_backend = requested;
+            start_backend();
+            return backend;
+        };
+        // (re)starts the requested backend once connected, falling back to
+        // bsd calls if the kernel can't run it. a running ring is kept when
+        // only its buffers change, so native_handle stays the same.
+        auto start_backend() -> void
+        {
+        #ifdef __linux__
+            bool polled = requested_backend == socket_backend::io_uring_polled;
+            if (requested_backend == socket_backend::bsd || socket == INVALID_SOCKET || !uring.valid() || uring.kernel_polling() != polled)
+            {
+                stop_backend();
+            }
+            if (requested_backend == socket_backend::bsd || socket == INVALID_SOCKET)
+            {
+                return;
+            }
+            if (batch.empty())
+            {
+                reserve_batch(default_batch_size, default_datagram_size);
+            }
+            if (uring.valid())
+            {
+                disarm_uring();
+                uring.unregister_buffer_ring(0);
+                uring_buffers.release();
+                uring_held.clear();
+            }
+
+            // room for the datagrams of the batch being read and those the
+            // kernel receives meanwhile.
+            unsigned buffers = std::bit_ceil(unsigned(std::min<std::size_t>(batch.size() * 4, 32768)));
+            std::size_t control_size = timestamps ? timestamp_control_size : 0;
+            std::size_t buffer_size = sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in) + control_size + batch_datagram_size;
+            if ((!uring.valid() && !uring.open(64, polled))
+                || !uring_buffers.allocate(buffers, buffer_size)
+                || !uring.register_buffer_ring(uring_buffers.get(), buffers, 0))
+            {
+                uring.close();
+                uring_buffers.release();
+                backend = socket_backend::bsd;
+                return;
+            }
+
+            uring_message = {};
+            uring_message.msg_namelen = sizeof(sockaddr_in);
+            uring_message.msg_controllen = control_size;
+            uring_unsupported = false;
+            backend = requested_backend;
+            arm_uring();
+            uring.submit();
+        #endif
+        };
+        auto stop_backend() -> void
+        {
+        #ifdef __linux__
+            if (!uring.valid())
+            {
+                return;
+            }
+
+            disarm_uring();
+            uring.close();
+            uring_buffers.release();
+            uring_held.clear();
+        #endif
+            backend = socket_backend::bsd;
+        };
+    #ifdef __linux__
+        // cancels the multishot receive, as the kernel mustn't write into the
+        // buffers once they're freed.
+        auto disarm_uring() -> void
+        {
+            if (uring_armed)
+            {
+                if (io_uring_sqe* sqe = uring.get_sqe(); sqe != nullptr)
+                {
+                    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                    sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+                    sqe->user_data = 1;
+                }
+                for (int attempt = 0; uring_armed && attempt < 100; ++attempt)
+                {
+                    if (!uring.wait(std::chrono::microseconds{ 1'000 }))
+                    {
+                        continue;
+                    }
+                    while (io_uring_cqe* cqe = uring.peek())
+                    {
+                        if (cqe->user_data == 0 && !(cqe->flags & IORING_CQE_F_MORE))
+                        {
+                            uring_armed = false;
+                        }
+                        uring.advance();
+                    }
+                }
+            }
+            uring_armed = false;
+        };
+        auto arm_uring() -> void
+        {
+            if (io_uring_sqe* sqe = uring.get_sqe(); sqe != nullptr)
+            {
+                sqe->opcode = IORING_OP_RECVMSG;
+                sqe->fd = socket;
+                sqe->addr = std::uint64_t(&uring_message);
+                sqe->len = 1;
+                sqe->ioprio = IORING_RECV_MULTISHOT;
+                sqe->flags = IOSQE_BUFFER_SELECT;
+                sqe->buf_group = 0;
+                sqe->user_data = 0;
+                uring_armed = true;
+            }
+        };
+        // up to limit datagrams from the completion queue, without a syscall
+        // unless it's empty and the socket is blocking.
+        auto read_uring(std::size_t limit) -> std::span<const received_datagram>
+        {
+            if (!uring_held.empty())
+            {
+                for (std::uint16_t id : uring_held)
+                {
+                    uring_buffers.add(id);
+                }
+                uring_buffers.publish();
+                uring_held.clear();
+            }
+            if (!uring_armed)
+            {
+                arm_uring();
+            }
+            if (blocking && uring.peek() == nullptr)
+            {
+                uring.wait(std::chrono::microseconds{ -1 });
+            }
+
+            std::size_t count = 0;
+            while (count < limit)
+            {
+                io_uring_cqe* entry = uring.peek();
+                if (entry == nullptr)
+                {
+                    break;
+                }
+                io_uring_cqe cqe = *entry;
+                uring.advance();
+
+                if (cqe.user_data != 0)
+                {
+                    continue;
+                }
+                if (!(cqe.flags & IORING_CQE_F_MORE))
+                {
+                    uring_armed = false;
+                }
+                if (cqe.res < 0)
+                {
+                    // -ENOBUFS only needs the buffers back, and re-arming.
+                    uring_unsupported |= cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP;
+                    continue;
+                }
+                if (!(cqe.flags & IORING_CQE_F_BUFFER))
+                {
+                    continue;
+                }
+
+                auto id = std::uint16_t(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                uring_held.push_back(id);
+                std::byte* buffer = uring_buffers.buffer_at(id);
+                io_uring_recvmsg_out out;
+                std::memcpy(&out, buffer, sizeof(out));
+                sockaddr_in source{};
+                std::memcpy(&source, buffer + sizeof(out), std::min<std::size_t>(out.namelen, sizeof(source)));
+                msghdr control{};
+                control.msg_control = buffer + sizeof(out) + uring_message.msg_namelen;
+                control.msg_controllen = out.controllen;
+                std::byte* payload = buffer + sizeof(out) + uring_message.msg_namelen + uring_message.msg_controllen;
+                batch[count++] = {
+                    .bytes = { payload, std::min<std::size_t>(out.payloadlen, batch_datagram_size) },
+                    .source_address = ntohl(source.sin_addr.s_addr),
+                    .source_port = ntohs(source.sin_port),
+                    .truncated = (out.flags & MSG_TRUNC) != 0,
+                    .received_at = control_timestamp(control),
+                };
+            }
+
+            // a kernel without multishot recvmsg refuses the first one.
+            if (uring_unsupported && count == 0)
+            {
+                std::cout << "receive_socket: io_uring receive unsupported, falling back.\n";
+                requested_backend = socket_backend::bsd;
+                stop_backend();
+                return read_batch();
+            }
+            if (!uring_armed)
+            {
+                arm_uring();
+            }
+            uring.submit();
+            return std::span{ batch }.first(count);
+        };
+        auto uring_bytes_available() -> int
+        {
+            io_uring_cqe* cqe = uring.peek();
+            if (cqe == nullptr || cqe->user_data != 0 || cqe->res < 0 || !(cqe->flags & IORING_CQE_F_BUFFER))
+            {
+                return 0;
+            }
+            io_uring_recvmsg_out out;
+            std::memcpy(&out, uring_buffers.buffer_at(std::uint16_t(cqe->flags >> IORING_CQE_BUFFER_SHIFT)), sizeof(out));
+            return int(std::min<std::size_t>(out.payloadlen, batch_datagram_size));
+        };
+    #endif
     };
 
     receive_socket::receive_socket() :
@@ -334,10 +1123,10 @@ namespace cigi
     {
         disconnect();
     };
-    auto receive_socket::connect(std::string_view ip, std::uint16_t port, std::string_view device) -> void
+    auto receive_socket::connect(std::string_view ip, std::uint16_t port, std::string_view device, const socket_options& options) -> socket_options_result
     {
         impl->disconnect();
-        impl->connect(ip, port, device);
+        return impl->connect(ip, port, device, options);
     };
     auto receive_socket::disconnect() -> void
     {
@@ -351,8 +1140,54 @@ namespace cigi
     {
         return impl->read_bytes(size, data);
     };
+    auto receive_socket::read_into(std::span<std::byte> buffer) const -> int
+    {
+        return impl->read_into(buffer);
+    };
     auto receive_socket::select(std::chrono::microseconds timeout) const -> bool
     {
         return impl->select(timeout);
     };
+    auto receive_socket::reserve_batch(std::size_t count, std::size_t datagram_size) -> void
+    {
+        impl->reserve_batch(count, datagram_size);
+    };
+    auto receive_socket::read_batch() -> std::span<const received_datagram>
+    {
+        return impl->read_batch();
+    };
+    auto receive_socket::set_timestamps(bool enable) -> bool
+    {
+        return impl->set_timestamps(enable);
+    };
+    auto receive_socket::set_backend(socket_backend backend) -> socket_backend
+    {
+        return impl->set_backend(backend);
+    };
+    auto receive_socket::backend() const -> socket_backend
+    {
+        return impl->backend;
+    };
+    auto receive_socket::batch_size() const -> std::size_t
+    {
+        return impl->batch.size();
+    };
+    auto receive_socket::set_blocking(bool blocking) -> bool
+    {
+        return impl->set_blocking(blocking);
+    };
+    auto receive_socket::native_handle() const -> std::intptr_t
+    {
+        if (impl->socket == INVALID_SOCKET)
+        {
+            return -1;
+        }
+    #ifdef __linux__
+        if (impl->backend != socket_backend::bsd)
+        {
+            return impl->uring.descriptor();
+        }
+    #endif
+        return std::intptr_t(impl->socket);
+    };
 };
\ No newline at end of file
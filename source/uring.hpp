@@ -0,0 +1,327 @@
+#pragma once
+
+// a minimal io_uring wrapper for the socket backends: the raw syscalls and
+// shared rings, without liburing. linux only.
+
+#ifdef __linux__
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+
+namespace cigi::detail
+{
+    struct uring
+    {
+        uring() = default;
+        uring(const uring&) = delete;
+        auto operator =(const uring&) -> uring& = delete;
+        ~uring()
+        {
+            close();
+        };
+
+        // false if the kernel lacks io_uring or the features used here
+        // (single mmap, waiting with a timeout).
+        auto open(unsigned entries, bool kernel_polling) -> bool
+        {
+            io_uring_params params{};
+            if (kernel_polling)
+            {
+                params.flags |= IORING_SETUP_SQPOLL;
+                params.sq_thread_idle = 1000;
+            }
+
+            fd = int(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0)
+            {
+                return false;
+            }
+            constexpr unsigned required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_EXT_ARG;
+            if ((params.features & required) != required)
+            {
+                close();
+                return false;
+            }
+            polled = kernel_polling;
+
+            ring_size = std::max(params.sq_off.array + params.sq_entries * sizeof(std::uint32_t), params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+            ring = ::mmap(nullptr, ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqe_memory = ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+            if (ring == MAP_FAILED || sqe_memory == MAP_FAILED)
+            {
+                if (sqe_memory != MAP_FAILED)
+                {
+                    ::munmap(sqe_memory, sqes_size);
+                }
+                ring = nullptr;
+                close();
+                return false;
+            }
+            sqes = static_cast<io_uring_sqe*>(sqe_memory);
+
+            auto* base = static_cast<std::byte*>(ring);
+            sq_head = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+            sq_tail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+            sq_flags = reinterpret_cast<unsigned*>(base + params.sq_off.flags);
+            sq_mask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+            sq_entries = params.sq_entries;
+            cq_head = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+            cq_tail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+            cq_mask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+            auto* array = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+            for (unsigned i = 0; i < sq_entries; ++i)
+            {
+                array[i] = i;
+            }
+            sqe_tail = *sq_tail;
+            submitted = sqe_tail;
+            return true;
+        };
+        auto close() -> void
+        {
+            if (sqes != nullptr)
+            {
+                ::munmap(sqes, sqes_size);
+                sqes = nullptr;
+            }
+            if (ring != nullptr)
+            {
+                ::munmap(ring, ring_size);
+                ring = nullptr;
+            }
+            if (fd >= 0)
+            {
+                ::close(fd);
+                fd = -1;
+            }
+        };
+        [[nodiscard]]
+        auto valid() const noexcept -> bool
+        {
+            return fd >= 0;
+        };
+        [[nodiscard]]
+        auto descriptor() const noexcept -> int
+        {
+            return fd;
+        };
+        [[nodiscard]]
+        auto kernel_polling() const noexcept -> bool
+        {
+            return polled;
+        };
+        [[nodiscard]]
+        auto capacity() const noexcept -> unsigned
+        {
+            return sq_entries;
+        };
+
+        // a zeroed submission slot, or null when they're all taken.
+        auto get_sqe() noexcept -> io_uring_sqe*
+        {
+            unsigned head = std::atomic_ref{ *sq_head }.load(std::memory_order_acquire);
+            if (sqe_tail - head >= sq_entries)
+            {
+                return nullptr;
+            }
+            io_uring_sqe* sqe = &sqes[sqe_tail++ & sq_mask];
+            std::memset(sqe, 0, sizeof(*sqe));
+            return sqe;
+        };
+        // publishes the prepared entries and, if wait_for isn't 0, waits for
+        // that many completions. with kernel polling, publishing takes no
+        // syscall unless the polling thread has gone idle.
+        auto submit(unsigned wait_for = 0) -> int
+        {
+            unsigned to_submit = sqe_tail - submitted;
+            submitted = sqe_tail;
+            std::atomic_ref{ *sq_tail }.store(sqe_tail, std::memory_order_release);
+
+            unsigned flags = wait_for != 0 ? IORING_ENTER_GETEVENTS : 0;
+            if (polled)
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (to_submit != 0 && (std::atomic_ref{ *sq_flags }.load(std::memory_order_relaxed) & IORING_SQ_NEED_WAKEUP))
+                {
+                    flags |= IORING_ENTER_SQ_WAKEUP;
+                }
+                to_submit = 0;
+            }
+            if (to_submit == 0 && flags == 0)
+            {
+                return 0;
+            }
+            return int(::syscall(__NR_io_uring_enter, fd, to_submit, wait_for, flags, nullptr, 0));
+        };
+        // submits anything pending, then waits for a completion for up to
+        // timeout (forever if negative). true if there is one.
+        auto wait(std::chrono::microseconds timeout) -> bool
+        {
+            submit();
+            if (peek() != nullptr)
+            {
+                return true;
+            }
+            if (timeout.count() == 0)
+            {
+                return false;
+            }
+
+            __kernel_timespec time{ .tv_sec = timeout.count() / 1'000'000, .tv_nsec = (timeout.count() % 1'000'000) * 1'000 };
+            io_uring_getevents_arg arg{ .sigmask = 0, .sigmask_sz = _NSIG / 8, .pad = 0, .ts = timeout.count() < 0 ? 0 : std::uint64_t(&time) };
+            ::syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+            return peek() != nullptr;
+        };
+
+        // the oldest unconsumed completion, or null.
+        auto peek() noexcept -> io_uring_cqe*
+        {
+            unsigned head = *cq_head;
+            if (head == std::atomic_ref{ *cq_tail }.load(std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+            return &cqes[head & cq_mask];
+        };
+        auto advance(unsigned count = 1) noexcept -> void
+        {
+            std::atomic_ref{ *cq_head }.store(*cq_head + count, std::memory_order_release);
+        };
+
+        auto register_buffer_ring(const void* buffers, unsigned entries, std::uint16_t group) -> bool
+        {
+            io_uring_buf_reg reg{};
+            reg.ring_addr = std::uint64_t(buffers);
+            reg.ring_entries = entries;
+            reg.bgid = group;
+            return ::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PBUF_RING, &reg, 1) == 0;
+        };
+        auto unregister_buffer_ring(std::uint16_t group) -> bool
+        {
+            io_uring_buf_reg reg{};
+            reg.bgid = group;
+            return ::syscall(__NR_io_uring_register, fd, IORING_UNREGISTER_PBUF_RING, &reg, 1) == 0;
+        };
+
+    private:
+        int fd = -1;
+        bool polled = false;
+
+        void* ring = nullptr;
+        std::size_t ring_size = 0;
+        io_uring_sqe* sqes = nullptr;
+        std::size_t sqes_size = 0;
+
+        unsigned* sq_head = nullptr;
+        unsigned* sq_tail = nullptr;
+        unsigned* sq_flags = nullptr;
+        unsigned sq_mask = 0;
+        unsigned sq_entries = 0;
+        unsigned sqe_tail = 0;
+        unsigned submitted = 0;
+
+        unsigned* cq_head = nullptr;
+        unsigned* cq_tail = nullptr;
+        unsigned cq_mask = 0;
+        io_uring_cqe* cqes = nullptr;
+    };
+
+    // a ring of buffers the kernel picks from for each datagram it receives
+    // (a provided buffer ring), handed back as they're consumed.
+    struct uring_buffer_ring
+    {
+        uring_buffer_ring() = default;
+        uring_buffer_ring(const uring_buffer_ring&) = delete;
+        auto operator =(const uring_buffer_ring&) -> uring_buffer_ring& = delete;
+        ~uring_buffer_ring()
+        {
+            release();
+        };
+
+        // entries must be a power of two.
+        auto allocate(unsigned count, std::size_t size) -> bool
+        {
+            release();
+            entries = count;
+            buffer_size = size;
+            ring_bytes = entries * sizeof(io_uring_buf);
+            void* memory = ::mmap(nullptr, ring_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED)
+            {
+                return false;
+            }
+            ring = static_cast<io_uring_buf*>(memory);
+            storage = new std::byte[entries * buffer_size];
+            tail = 0;
+            for (unsigned id = 0; id < entries; ++id)
+            {
+                add(std::uint16_t(id));
+            }
+            publish();
+            return true;
+        };
+        auto release() -> void
+        {
+            if (ring != nullptr)
+            {
+                ::munmap(ring, ring_bytes);
+                ring = nullptr;
+            }
+            delete[] storage;
+            storage = nullptr;
+        };
+
+        auto add(std::uint16_t id) noexcept -> void
+        {
+            io_uring_buf& buffer = ring[tail++ & (entries - 1)];
+            buffer.addr = std::uint64_t(buffer_at(id));
+            buffer.len = unsigned(buffer_size);
+            buffer.bid = id;
+        };
+        auto publish() noexcept -> void
+        {
+            // the tail overlays the first entry's resv.
+            std::atomic_ref{ ring[0].resv }.store(tail, std::memory_order_release);
+        };
+
+        [[nodiscard]]
+        auto buffer_at(std::uint16_t id) const noexcept -> std::byte*
+        {
+            return storage + std::size_t(id) * buffer_size;
+        };
+        [[nodiscard]]
+        auto get() const noexcept -> const void*
+        {
+            return ring;
+        };
+        [[nodiscard]]
+        auto size() const noexcept -> unsigned
+        {
+            return entries;
+        };
+
+    private:
+        // io_uring_buf_ring's flexible array isn't laid out the same in C++
+        // (its empty struct takes a byte), so the entries are addressed
+        // directly.
+        io_uring_buf* ring = nullptr;
+        std::size_t ring_bytes = 0;
+        std::byte* storage = nullptr;
+        unsigned entries = 0;
+        std::size_t buffer_size = 0;
+        std::uint16_t tail = 0;
+    };
+};
+
+#endif
@@ -33,7 +33,9 @@
 #include "cigi/host/symbol_clone.hpp"
 #include "cigi/host/symbol_control.hpp"
 #include "cigi/host/short_symbol_control.hpp"
+#include "cigi/packet_view.hpp"
 
+#include <array>
 #include <iostream>
 
 #include <gtest/gtest.h>
@@ -160,4 +162,108 @@ TEST(host_packets, print_host_packets)
     ssc.set_color(0, 255, 127, 63, 31);
     ssc.set_position_u(1, 1.2e34f);
     std::cout << ssc << "\n\n";
-};
\ No newline at end of file
+};
+TEST(host_packets, serialize_into_matches_serialize)
+{
+    std::array<std::byte, 256> buffer{};
+
+    cigi::entity_control ec;
+    ec.entity_id = 0xBEEF;
+    ec.latitude = 12.5;
+    auto [ec_data, ec_errors] = cigi::entity_control::serialize(ec);
+    auto [ec_size, ec_into_errors] = cigi::entity_control::serialize_into(ec, buffer);
+    EXPECT_EQ(ec_into_errors, cigi::serialized_data::errors::none);
+    ASSERT_EQ(ec_size, ec_data.size());
+    EXPECT_TRUE(std::equal(ec_data.data.begin(), ec_data.data.end(), buffer.begin()));
+
+    cigi::symbol_text_definition std;
+    std.set_text("Hello World!");
+    auto [std_data, std_errors] = cigi::symbol_text_definition::serialize(std);
+    auto [std_size, std_into_errors] = cigi::symbol_text_definition::serialize_into(std, buffer);
+    EXPECT_EQ(std_into_errors, cigi::serialized_data::errors::none);
+    ASSERT_EQ(std_size, std_data.size());
+    EXPECT_TRUE(std::equal(std_data.data.begin(), std_data.data.end(), buffer.begin()));
+
+    cigi::symbol_line_definition sld;
+    sld.add_vertex({ 1.f, 2.f });
+    sld.add_vertex({ 3.f, 4.f });
+    auto [sld_size, sld_errors] = cigi::symbol_line_definition::serialize_into(sld, buffer);
+    EXPECT_EQ(sld_errors, cigi::serialized_data::errors::none);
+    EXPECT_EQ(sld_size, 32);
+
+    // too small a destination must not be written to.
+    std::array<std::byte, 8> small{};
+    auto [small_size, small_errors] = cigi::entity_control::serialize_into(ec, small);
+    EXPECT_EQ(small_size, 0);
+    EXPECT_EQ(small_errors, cigi::serialized_data::errors::insufficient_buffer);
+    auto [small_text_size, small_text_errors] = cigi::symbol_text_definition::serialize_into(std, small);
+    EXPECT_EQ(small_text_size, 0);
+    EXPECT_EQ(small_text_errors, cigi::serialized_data::errors::insufficient_buffer);
+};
+
+
+TEST(host_packets, entity_control_view)
+{
+    cigi::entity_control ec;
+    ec.entity_id = 0x1234;
+    ec.entity_state = cigi::active_t::active;
+    ec.ground_ocean_clamp = cigi::entity_control::ground_ocean_clamp_t::conformal;
+    ec.animation_state = cigi::entity_control::animation_state_t::continue_;
+    ec.yaw = 270.f;
+    ec.latitude = -33.5;
+    ec.longitude = 151.25;
+    ec.altitude = 1000.0;
+
+    std::array<std::byte, 48> buffer{};
+    cigi::entity_control::serialize_into(ec, buffer);
+
+    cigi::packet_view<cigi::entity_control> view{ buffer };
+    ASSERT_TRUE(view.valid());
+    EXPECT_EQ(view.entity_id(), 0x1234);
+    EXPECT_EQ(view.entity_state(), cigi::active_t::active);
+    EXPECT_EQ(view.ground_ocean_clamp(), cigi::entity_control::ground_ocean_clamp_t::conformal);
+    EXPECT_EQ(view.animation_state(), cigi::entity_control::animation_state_t::continue_);
+    EXPECT_EQ(view.yaw(), 270.f);
+    EXPECT_EQ(view.latitude(), -33.5);
+    EXPECT_EQ(view.x_offset(), -33.5);
+    EXPECT_EQ(view.get<&cigi::entity_control::longitude>(), 151.25);
+    EXPECT_EQ(view.altitude(), 1000.0);
+
+    // the same bytes in the opposite order read back identically.
+    std::array<std::byte, 48> swapped = buffer;
+    std::reverse(swapped.begin() + 2, swapped.begin() + 4);
+    std::reverse(swapped.begin() + 24, swapped.begin() + 32);
+    auto other = std::endian::native == std::endian::little ? std::endian::big : std::endian::little;
+    cigi::packet_view<cigi::entity_control> swapped_view{ swapped, other };
+    EXPECT_EQ(swapped_view.entity_id(), 0x1234);
+    EXPECT_EQ(swapped_view.latitude(), -33.5);
+
+    cigi::packet_view<cigi::entity_control> short_view{ std::span{ buffer }.first(20) };
+    EXPECT_FALSE(short_view.valid());
+};
+TEST(host_packets, variable_payloads_are_inline)
+{
+    static_assert(std::is_trivially_copyable_v<cigi::symbol_text_definition>);
+    static_assert(std::is_trivially_copyable_v<cigi::symbol_line_definition>);
+    static_assert(std::is_trivially_copyable_v<cigi::symbol_circle_definition>);
+
+    cigi::symbol_line_definition sld;
+    for (int i = 0; i < 29; ++i)
+    {
+        EXPECT_TRUE(sld.add_vertex({ float(i), -float(i) }));
+    }
+    EXPECT_FALSE(sld.add_vertex({}));
+    EXPECT_EQ(sld.packet_size.value, 16 + 8 * 29);
+
+    auto [data, errors] = cigi::symbol_line_definition::serialize(sld);
+    ASSERT_EQ(errors, cigi::serialized_data::errors::none);
+    cigi::symbol_line_definition copy;
+    ASSERT_EQ(cigi::symbol_line_definition::deserialize(data, copy), cigi::serialized_data::errors::none);
+    EXPECT_EQ(copy.vertices.size(), 29);
+    EXPECT_EQ(copy.vertices[28].v, -28.f);
+
+    cigi::symbol_text_definition std1;
+    std::string longest(235, 'x');
+    EXPECT_TRUE(std1.set_text(longest));
+    EXPECT_EQ(std1.get_text(), longest);
+};
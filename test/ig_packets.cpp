@@ -20,6 +20,8 @@
 
 #include <gtest/gtest.h>
 
+static_assert(std::is_trivially_copyable_v<cigi::image_generator_message>);
+
 TEST(ig_packets, print_ig_packets)
 {
     cigi::start_of_frame sof;
@@ -1,5 +1,11 @@
 #include "cigi/session.hpp"
 #include "cigi/host/symbol_text_definition.hpp"
+#include "cigi/byte_swap.hpp"
+#include "cigi/columns.hpp"
+#include "cigi/event_loop.hpp"
+#include "cigi/loopback.hpp"
+#include "cigi/state_mirror.hpp"
+#include "cigi/session_group.hpp"
 
 #include <iostream>
 #include <thread>
@@ -20,20 +26,1393 @@ TEST(other, test_network)
 
     std::cout << std1 << "\n\n";
 
+    // in-process, so nothing to wait for.
+    cigi::loopback_link link;
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect(link.host());
+    ig.connect(link.ig());
+    host.write(std1);
+    host.flush();
+
+    auto received = ig.read_async<cigi::symbol_text_definition>().get();
+    std::cout << received << "\n\n";
+    EXPECT_EQ(received.symbol_id, 0xDEAD);
+    EXPECT_EQ(received.font_id, std1.font_id);
+    EXPECT_EQ(received.get_text(), std1.get_text());
+};
+
+TEST(other, byte_swap_matches_fields)
+{
+    // a plain field-by-field swap, to check the shuffles against.
+    auto reference = []<typename T>(std::vector<std::byte> bytes)
+    {
+        auto swap = [&](const auto& fields, std::size_t base)
+        {
+            for (const auto& field : fields)
+            {
+                if (!field.alias && field.bit_width == 0)
+                {
+                    std::reverse(bytes.begin() + base + field.offset, bytes.begin() + base + field.offset + field.size);
+                }
+            }
+        };
+
+        swap(T::fields, 0);
+        if constexpr (requires { T::element_fields; })
+        {
+            std::size_t fixed_size = T::fields.back().offset + T::fields.back().size;
+            std::size_t element_size = T::element_fields.back().offset + T::element_fields.back().size;
+            for (std::size_t offset = fixed_size; offset < bytes.size(); offset += element_size)
+            {
+                swap(T::element_fields, offset);
+            }
+        }
+        return bytes;
+    };
+
+    cigi::all_packets::for_each([&]<typename T>()
+    {
+        T packet;
+        if constexpr (std::same_as<T, cigi::symbol_line_definition>)
+        {
+            packet.add_vertex({ 1.f, 2.f });
+            packet.add_vertex({ 3.f, 4.f });
+            packet.add_vertex({ 5.f, 6.f });
+        }
+        auto [data, errors] = T::serialize(packet);
+        ASSERT_EQ(errors, cigi::serialized_data::errors::none);
+
+        // fill with a pattern so every swapped byte is distinguishable.
+        for (std::size_t i = 2; i < data.data.size(); ++i)
+        {
+            data.data[i] = std::byte(i);
+        }
+
+        auto expected = reference.template operator()<T>({ data.data.begin(), data.data.end() });
+        ASSERT_TRUE(cigi::byte_swap_packet(data.data));
+        EXPECT_TRUE(std::ranges::equal(data.data, expected)) << "packet id " << int(decltype(T::packet_id)::value);
+    });
+};
+
+TEST(other, session_swaps_opposite_endian_peer)
+{
+    cigi::ig_control igc;
+    cigi::entity_control ec;
+    ec.entity_id = 0x1234;
+    ec.yaw = 90.f;
+    ec.latitude = 45.0;
+
+    std::array<std::byte, 72> datagram{};
+    cigi::ig_control::serialize_into(igc, std::span{ datagram }.first(24));
+    cigi::entity_control::serialize_into(ec, std::span{ datagram }.subspan(24));
+    // what a peer of the opposite byte order would have sent.
+    cigi::byte_swap_datagram(datagram);
+    ASSERT_NE(cigi::detect_byte_order(datagram), std::endian::native);
+
     cigi::session_network session;
-    session.connect("127.255.255.255", 34567, 34567);
-    session.write(std1);
+    session.receive_datagram(datagram);
+    EXPECT_NE(session.peer_byte_order, std::endian::native);
+
+    auto received = session.read<cigi::entity_control>();
+    ASSERT_TRUE(received.has_value());
+    EXPECT_EQ(received->entity_id, 0x1234);
+    EXPECT_EQ(received->yaw.value, 90.f);
+    EXPECT_EQ(received->latitude.value, 45.0);
+};
+TEST(other, fields_cover_every_byte_once)
+{
+    cigi::all_packets::for_each([]<typename T>()
+    {
+        // each byte is either one whole field or shared by bitfields.
+        std::array<int, 256> whole{};
+        std::array<int, 256> bits{};
+        std::size_t end = 0;
+        for (const auto& field : T::fields)
+        {
+            if (field.alias)
+            {
+                continue;
+            }
+            for (std::size_t i = field.offset; i < field.offset + field.size; ++i)
+            {
+                ++(field.bit_width != 0 ? bits : whole)[i];
+            }
+            end = std::max<std::size_t>(end, field.offset + field.size);
+        }
+
+        int id = decltype(T::packet_id)::value;
+        if constexpr (cigi::is_constant_v<decltype(T::packet_size)>)
+        {
+            EXPECT_EQ(end, sizeof(T)) << "packet id " << id;
+        }
+        for (std::size_t i = 0; i < end; ++i)
+        {
+            EXPECT_TRUE(whole[i] == 1 ? bits[i] == 0 : bits[i] > 0) << "packet id " << id << ", byte " << i;
+        }
+
+        // and a default packet passes its own checks.
+        auto [data, errors] = T::serialize(T{});
+        EXPECT_EQ(cigi::validate_fields<T>(data.data), cigi::serialized_data::errors::none) << "packet id " << id;
+    });
+};
+
+TEST(other, fields_read_and_validate)
+{
+    cigi::entity_control ec;
+    ec.entity_id = 0x1234;
+    ec.entity_state = cigi::active_t::active;
+    ec.latitude = 45.0;
+
+    std::array<std::byte, sizeof(cigi::entity_control)> bytes{};
+    cigi::entity_control::serialize_into(ec, bytes);
+
+    cigi::packet_view<cigi::entity_control> view{ bytes };
+    EXPECT_EQ(view.field<"entity_id">(), 0x1234);
+    EXPECT_EQ(view.field<"entity_state">(), cigi::u8(cigi::active_t::active));
+    EXPECT_EQ(view.field<"latitude">(), 45.0);
+    EXPECT_EQ(cigi::validate_fields<cigi::entity_control>(bytes), cigi::serialized_data::errors::none);
+
+    // latitude is bounded to [-90, 90].
+    cigi::f64 latitude = 100.0;
+    std::memcpy(bytes.data() + cigi::entity_control::fields[cigi::field_index<cigi::entity_control>("latitude")].offset, &latitude, sizeof(latitude));
+    EXPECT_EQ(cigi::validate_fields<cigi::entity_control>(bytes), cigi::serialized_data::errors::out_of_bounds);
+    EXPECT_EQ(cigi::validate_fields<cigi::entity_control>(std::span{ bytes }.first(20)), cigi::serialized_data::errors::truncated_packet);
+
+    // attached, the same bytes are an x offset, which isn't bounded.
+    ec.attach_state = cigi::attach_t::attach;
+    ec.x_offset = 100.0;
+    cigi::entity_control::serialize_into(ec, bytes);
+    EXPECT_EQ(cigi::validate_fields<cigi::entity_control>(bytes), cigi::serialized_data::errors::none);
+
+    // a surface attached to a view has a bottom edge in place of a yaw.
+    cigi::symbol_surface_definition surface;
+    surface.attach_type = cigi::symbol_surface_definition::attach_t::view;
+    surface.bottom = -0.5f;
+    std::array<std::byte, sizeof(cigi::symbol_surface_definition)> surface_bytes{};
+    cigi::symbol_surface_definition::serialize_into(surface, surface_bytes);
+    EXPECT_EQ(cigi::validate_fields<cigi::symbol_surface_definition>(surface_bytes), cigi::serialized_data::errors::none);
+    surface_bytes[4] &= ~std::byte{ 0x02 };
+    EXPECT_EQ(cigi::validate_fields<cigi::symbol_surface_definition>(surface_bytes), cigi::serialized_data::errors::out_of_bounds);
+};
+
+TEST(other, decode_columns_matches_packets)
+{
+    // entity controls interleaved with other packets, more than one batch.
+    std::vector<std::byte> datagram(sizeof(cigi::ig_control));
+    cigi::ig_control::serialize_into(cigi::ig_control{}, datagram);
+    std::vector<cigi::entity_control> sent;
+    for (int i = 0; i < 70; ++i)
+    {
+        cigi::entity_control ec;
+        ec.entity_id = cigi::u16(1000 + i);
+        ec.entity_state = cigi::active_t(i % 3);
+        ec.latitude = -45.0 + i;
+        ec.yaw = float(i) * 2.f;
+        sent.push_back(ec);
+
+        std::size_t offset = datagram.size();
+        datagram.resize(offset + sizeof(ec));
+        cigi::entity_control::serialize_into(ec, std::span{ datagram }.subspan(offset));
+        if (i % 4 == 0)
+        {
+            offset = datagram.size();
+            datagram.resize(offset + sizeof(cigi::articulated_part_control));
+            cigi::articulated_part_control::serialize_into(cigi::articulated_part_control{}, std::span{ datagram }.subspan(offset));
+        }
+    }
+
+    std::array<cigi::u16, 128> ids{};
+    std::array<cigi::u8, 128> states{};
+    std::array<cigi::f64, 128> latitudes{};
+    std::array<cigi::f32, 128> yaws{};
+    auto rows = cigi::decode_columns<cigi::entity_control, "entity_id", "entity_state", "latitude", "yaw">(datagram, ids, states, latitudes, yaws);
+    ASSERT_EQ(rows, sent.size());
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        EXPECT_EQ(ids[i], sent[i].entity_id);
+        EXPECT_EQ(states[i], cigi::u8(sent[i].entity_state));
+        EXPECT_EQ(latitudes[i], sent[i].latitude.value);
+        EXPECT_EQ(yaws[i], sent[i].yaw.value);
+    }
+
+    // stops at the shortest column, and works the same off the session's queue.
+    cigi::session_network session;
+    session.receive_datagram(datagram);
+    std::array<cigi::u16, 5> few{};
+    EXPECT_EQ((session.read_columns<cigi::entity_control, "entity_id">(few)), few.size());
+    EXPECT_EQ(few[4], 1004);
+    EXPECT_EQ((session.read_columns<cigi::entity_control, "entity_id", "yaw">(ids, yaws)), sent.size() - few.size());
+    EXPECT_EQ(ids[0], 1005);
+    EXPECT_EQ(yaws[64], sent[69].yaw.value);
+};
+
+TEST(other, serialized_data_is_inline)
+{
+    cigi::entity_control ec;
+    ec.entity_id = 0x1234;
+    auto [data, errors] = cigi::entity_control::serialize(ec);
+    ASSERT_EQ(errors, cigi::serialized_data::errors::none);
+    ASSERT_EQ(data.size(), sizeof(ec));
+
+    // the bytes live inside the object, and move with it.
+    auto start = (const std::byte*)&data;
+    EXPECT_GE(data.start_pointer(), start);
+    EXPECT_LE(data.start_pointer() + data.size(), start + sizeof(data));
+
+    cigi::serialized_data moved = std::move(data);
+    EXPECT_EQ(moved.p.base, moved.start_pointer());
+    EXPECT_TRUE(std::ranges::equal(moved.data, cigi::entity_control::serialize(ec).first.data));
+
+    // anything beyond the largest possible packet is dropped.
+    std::vector<std::byte> oversized(300, std::byte{ 1 });
+    EXPECT_EQ(cigi::serialized_data{ oversized }.size(), cigi::packet_buffer::capacity);
+};
+
+TEST(other, datagram_index_checks_sizes)
+{
+    static_assert(cigi::packet_sizes[1].minimum == sizeof(cigi::ig_control));
+    static_assert(cigi::packet_sizes[32].minimum == 16 && cigi::packet_sizes[32].maximum == 248);
+
+    std::array<std::byte, 24 + 48 + 48 + 8> datagram{};
+    cigi::ig_control::serialize_into(cigi::ig_control{}, std::span{ datagram }.first(24));
+    cigi::entity_control ec;
+    ec.entity_id = 7;
+    cigi::entity_control::serialize_into(ec, std::span{ datagram }.subspan(24, 48));
+    // an entity control that claims to be 16 bytes, as from a faulty peer.
+    cigi::entity_control::serialize_into(ec, std::span{ datagram }.subspan(72, 48));
+    datagram[73] = std::byte{ 16 };
+    // and another that claims more bytes than are left.
+    datagram[89] = std::byte{ 48 };
+    datagram[88] = std::byte{ 2 };
+
+    cigi::datagram_index index{ datagram };
+    ASSERT_EQ(index.size(), 2);
+    EXPECT_EQ(index.errors(), cigi::serialized_data::errors::truncated_packet);
+    EXPECT_EQ(index[1].offset, 24);
+    EXPECT_EQ(index.count(2), 1);
+    EXPECT_FALSE(index.view<cigi::entity_control>(0).has_value());
+    EXPECT_EQ(index.view<cigi::entity_control>(1)->entity_id(), 7);
+
+    // the session drops the short packet rather than reading past it.
+    cigi::session_network session;
+    session.receive_datagram(datagram);
+    EXPECT_EQ(session.read_all<cigi::entity_control>().size(), 1);
+
+    // and default_deserialize refuses one handed to it directly.
+    cigi::serialized_data shorter{ datagram.data() + 72, 16 };
+    cigi::entity_control out;
+    EXPECT_EQ(cigi::entity_control::deserialize(shorter, out), cigi::serialized_data::errors::truncated_packet);
+};
+
+TEST(other, packet_queues_overflow)
+{
+    cigi::packet_queues queues;
+    queues.set_capacity(2, 3);
+
+    std::array<std::byte, sizeof(cigi::entity_control)> bytes{};
+    auto push = [&](cigi::u16 entity_id)
+    {
+        cigi::entity_control ec;
+        ec.entity_id = entity_id;
+        cigi::entity_control::serialize_into(ec, bytes);
+        return queues.push(bytes);
+    };
+    auto front_id = [&]
+    {
+        return cigi::packet_view<cigi::entity_control>{ queues.front(2) }.entity_id();
+    };
+
+    for (cigi::u16 i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(push(i));
+    }
+    EXPECT_FALSE(push(3));
+    EXPECT_EQ(queues.size(2), 3);
+    EXPECT_EQ(front_id(), 1);
+
+    queues.set_overflow_policy(cigi::overflow_policy::drop_newest);
+    EXPECT_FALSE(push(4));
+    EXPECT_EQ(front_id(), 1);
+    EXPECT_EQ(cigi::packet_view<cigi::entity_control>{ queues.at(2, 2) }.entity_id(), 3);
+
+    queues.pop(2, 2);
+    EXPECT_TRUE(push(5));
+    EXPECT_EQ(queues.size(2), 2);
+    EXPECT_EQ(queues.stats(2).high_water_mark, 3);
+    EXPECT_EQ(queues.stats(2).dropped, 2);
+    EXPECT_TRUE(queues.empty(1));
+};
+
+TEST(other, session_keeps_bursts)
+{
+    // far more of one id than a ring starts with, all queued at once.
+    cigi::loopback_link link;
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect(link.host());
+    ig.connect(link.ig());
+
+    constexpr cigi::u16 count = 1000;
+    cigi::entity_control ec;
+    host.write(cigi::ig_control{});
+    for (cigi::u16 i = 0; i < count; ++i)
+    {
+        ec.entity_id = i;
+        host.write(ec);
+    }
+    host.flush();
+    ig.drain();
+
+    constexpr auto id = decltype(cigi::entity_control::packet_id)::value;
+    EXPECT_EQ(ig.incoming.size(id), count);
+    EXPECT_EQ(ig.incoming.stats(id).dropped, 0);
+    auto received = ig.read_all<cigi::entity_control>();
+    ASSERT_EQ(received.size(), count);
+    for (cigi::u16 i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(received[i].entity_id, i);
+    }
+};
+
+TEST(other, session_dispatches_to_handlers)
+{
+    std::array<std::byte, 24 + 48 + 8 + 32> datagram{};
+    cigi::ig_control igc;
+    igc.host_frame_number = 42;
+    cigi::ig_control::serialize_into(igc, std::span{ datagram }.first(24));
+    cigi::entity_control ec;
+    ec.entity_id = 7;
+    cigi::entity_control::serialize_into(ec, std::span{ datagram }.subspan(24, 48));
+    // a user-defined packet, and a known one nobody handles.
+    datagram[72] = std::byte{ 201 };
+    datagram[73] = std::byte{ 8 };
+    cigi::rate_control::serialize_into(cigi::rate_control{}, std::span{ datagram }.subspan(80));
+
+    cigi::session_network session;
+    cigi::u32 frame = 0;
+    cigi::u16 entity = 0;
+    int unknown = 0;
+    session.on<cigi::ig_control>([&](const cigi::ig_control& packet)
+    {
+        frame = packet.host_frame_number;
+    });
+    session.on<cigi::entity_control>([&](cigi::packet_view<cigi::entity_control> view)
+    {
+        entity = view.entity_id();
+    });
+    session.on_unknown([&](std::span<const std::byte> bytes)
+    {
+        unknown += cigi::u8(bytes[0]) == 201;
+    });
+    session.receive_datagram(datagram);
+
+    EXPECT_EQ(frame, 42);
+    EXPECT_EQ(entity, 7);
+    EXPECT_EQ(unknown, 1);
+    EXPECT_FALSE(session.read<cigi::entity_control>().has_value());
+    EXPECT_TRUE(session.read<cigi::rate_control>().has_value());
+
+    session.off<cigi::entity_control>();
+    session.receive_datagram(datagram);
+    EXPECT_TRUE(session.read<cigi::entity_control>().has_value());
+};
+
+TEST(other, datagram_ring_hands_off_in_order)
+{
+    cigi::datagram_ring ring{ 8, 16 };
+    constexpr cigi::u32 count = 10'000;
+
+    std::jthread producer{ [&]
+    {
+        for (cigi::u32 i = 0; i < count;)
+        {
+            if (auto buffer = ring.acquire(); !buffer.empty())
+            {
+                std::memcpy(buffer.data(), &i, sizeof(i));
+                ring.commit(sizeof(i));
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    } };
+
+    for (cigi::u32 expected = 0; expected < count;)
+    {
+        if (auto datagram = ring.front())
+        {
+            ASSERT_EQ(datagram->size(), sizeof(cigi::u32));
+            cigi::u32 value;
+            std::memcpy(&value, datagram->data(), sizeof(value));
+            ASSERT_EQ(value, expected);
+            ring.pop();
+            ++expected;
+        }
+        else
+        {
+            // the producer wakes the consumer on each commit.
+            using namespace std::chrono_literals;
+            ASSERT_TRUE(ring.wait(1s));
+        }
+    }
+    EXPECT_FALSE(ring.wait(std::chrono::microseconds{ 100 }));
+
+    EXPECT_LE(ring.high_water_mark(), ring.capacity());
+    EXPECT_EQ(ring.occupancy(), 0);
+};
+
+TEST(other, session_receive_thread)
+{
+    cigi::session_network sender;
+    cigi::session_network receiver;
+    sender.connect("127.0.0.1", 34571, 34572);
+    // only a connected socket can be read from a thread.
+    EXPECT_FALSE(receiver.start_receive_thread());
+    cigi::loopback_link link;
+    receiver.connect(link.ig());
+    EXPECT_FALSE(receiver.start_receive_thread());
+    EXPECT_EQ(receiver.receive_ring(), nullptr);
+
+    receiver.connect("127.0.0.1", 34570, 34571);
+    ASSERT_TRUE(receiver.start_receive_thread());
+
+    cigi::entity_control ec;
+    ec.entity_id = 99;
+    sender.write(cigi::ig_control{});
+    sender.write(ec);
+    sender.flush();
+
+    using namespace std::chrono_literals;
+    ASSERT_TRUE(receiver.poll(1s));
+    auto received = receiver.read<cigi::entity_control>();
+    ASSERT_TRUE(received.has_value());
+    EXPECT_EQ(received->entity_id, 99);
+    EXPECT_EQ(receiver.receive_ring()->overruns(), 0);
+
+    receiver.stop_receive_thread();
+    EXPECT_EQ(receiver.receive_ring(), nullptr);
+};
+
+TEST(other, session_awaits_responses)
+{
+    constexpr cigi::u16 count = 1000;
+    std::vector<cigi::f64> heights(count, -1.0);
+    int timed_out = 0;
+    int cancelled = 0;
+    {
+        cigi::session_network session;
+        auto query = [&](cigi::u16 id) -> cigi::detached_task
+        {
+            auto response = co_await session.next<cigi::hat_hot_response>(id);
+            heights[id] = response.has_value() ? response->height : -2.0;
+        };
+        for (cigi::u16 id = 0; id < count; ++id)
+        {
+            query(id);
+        }
+        auto expiring = [&]() -> cigi::detached_task
+        {
+            auto response = co_await session.next<cigi::line_of_sight_response>(cigi::wait_clock::now());
+            timed_out += !response.has_value() && response.error() == cigi::wait_error::timed_out;
+        };
+        expiring();
+        auto abandoned = [&]() -> cigi::detached_task
+        {
+            auto response = co_await session.next<cigi::hat_hot_response>([](auto view) { return view.template field<"hat_hot_id">() == count; });
+            cancelled += !response.has_value() && response.error() == cigi::wait_error::cancelled;
+        };
+        abandoned();
+        EXPECT_EQ(session.waiters.size(), count + 2);
+
+        session.expire_waits();
+        EXPECT_EQ(timed_out, 1);
+
+        // answered out of order, all in one datagram.
+        std::vector<std::byte> datagram(count * sizeof(cigi::hat_hot_response));
+        for (cigi::u16 i = 0; i < count; ++i)
+        {
+            cigi::hat_hot_response response;
+            response.hat_hot_id = cigi::u16(count - 1 - i);
+            response.height = response.hat_hot_id * 0.5;
+            cigi::hat_hot_response::serialize_into(response, std::span{ datagram }.subspan(i * sizeof(response)));
+        }
+        session.receive_datagram(datagram);
+
+        EXPECT_EQ(session.waiters.size(), 1);
+        EXPECT_TRUE(session.incoming.empty(decltype(cigi::hat_hot_response::packet_id)::value));
+        for (cigi::u16 id = 0; id < count; ++id)
+        {
+            ASSERT_EQ(heights[id], id * 0.5);
+        }
+    }
+    EXPECT_EQ(cancelled, 1);
+};
+
+TEST(other, event_loop_drains_sessions)
+{
+    constexpr std::size_t channels = 3;
+    std::array<cigi::session_network, channels> hosts;
+    std::array<cigi::session_network, channels> igs;
+    cigi::event_loop loop;
+    for (std::size_t i = 0; i < channels; ++i)
+    {
+        auto port = std::uint16_t(34573 + i);
+        hosts[i].connect("127.0.0.1", port, std::uint16_t(34583 + i));
+        igs[i].connect("127.0.0.1", std::uint16_t(34593 + i), port);
+        ASSERT_TRUE(loop.add(igs[i]));
+    }
+    EXPECT_FALSE(loop.add(igs[0]));
+    EXPECT_EQ(loop.size(), channels);
+
+    // two datagrams per channel, both read on one readiness edge.
+    for (std::size_t i = 0; i < channels; ++i)
+    {
+        cigi::entity_control ec;
+        ec.entity_id = cigi::u16(i);
+        for (int datagram = 0; datagram < 2; ++datagram)
+        {
+            hosts[i].write(ec);
+            hosts[i].flush();
+        }
+    }
+
+    using namespace std::chrono_literals;
+    std::size_t datagrams = 0;
+    for (int attempt = 0; attempt < 100 && datagrams < 2 * channels; ++attempt)
+    {
+        datagrams += loop.run_once(10ms);
+    }
+    EXPECT_EQ(datagrams, 2 * channels);
+    for (std::size_t i = 0; i < channels; ++i)
+    {
+        auto received = igs[i].read_all<cigi::entity_control>();
+        ASSERT_EQ(received.size(), 2);
+        EXPECT_EQ(received[0].entity_id, i);
+    }
+
+    loop.remove(igs[1]);
+    EXPECT_EQ(loop.size(), channels - 1);
+};
+
+TEST(other, receive_batch_with_sources)
+{
+    cigi::session_network host;
+    cigi::receive_socket socket;
+    host.connect("127.0.0.1", 34576, 34586);
+    socket.connect("", 34576, "");
+    socket.reserve_batch(8, 512);
+    EXPECT_EQ(socket.batch_size(), 8);
+
+    cigi::entity_control ec;
+    for (cigi::u16 i = 0; i < 5; ++i)
+    {
+        ec.entity_id = i;
+        host.write(ec);
+        host.flush();
+    }
+
+    using namespace std::chrono_literals;
+    ASSERT_TRUE(socket.select(1s));
+    ASSERT_TRUE(socket.set_blocking(false));
+    std::size_t received = 0;
+    for (int attempt = 0; attempt < 100 && received < 5; ++attempt)
+    {
+        for (const auto& datagram : socket.read_batch())
+        {
+            ASSERT_EQ(datagram.bytes.size(), sizeof(cigi::entity_control));
+            EXPECT_FALSE(datagram.truncated);
+            EXPECT_EQ(datagram.source_address, 0x7f000001u);
+            EXPECT_NE(datagram.source_port, 0);
+            cigi::u16 id;
+            std::memcpy(&id, datagram.bytes.data() + 2, sizeof(id));
+            EXPECT_EQ(id, received++);
+        }
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(received, 5);
+};
+
+TEST(other, send_packets_splits_at_packet_boundaries)
+{
+    cigi::send_socket socket;
+    cigi::receive_socket receiver;
+    socket.connect("127.0.0.1", 34577);
+    receiver.connect("", 34577, "");
+    receiver.set_blocking(false);
+    socket.set_mtu(3 * sizeof(cigi::entity_control) + 8);
+
+    std::array<std::array<std::byte, sizeof(cigi::entity_control)>, 7> packets{};
+    std::vector<std::span<const std::byte>> spans;
+    for (std::size_t i = 0; i < packets.size(); ++i)
+    {
+        cigi::entity_control ec;
+        ec.entity_id = cigi::u16(i);
+        cigi::entity_control::serialize_into(ec, packets[i]);
+        spans.emplace_back(packets[i]);
+    }
+    EXPECT_EQ(socket.send_packets(spans), 3);
+    EXPECT_EQ(socket.packets_sent(), 3);
+    EXPECT_EQ(socket.bytes_sent(), packets.size() * sizeof(cigi::entity_control));
+
+    using namespace std::chrono_literals;
+    std::vector<std::size_t> sizes;
+    for (int attempt = 0; attempt < 100 && sizes.size() < 3; ++attempt)
+    {
+        for (const auto& datagram : receiver.read_batch())
+        {
+            sizes.push_back(datagram.bytes.size());
+        }
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(sizes, (std::vector<std::size_t>{ 144, 144, 48 }));
+};
+
+TEST(other, io_uring_backend)
+{
+    if (!cigi::io_uring_available())
+    {
+        GTEST_SKIP() << "no io_uring";
+    }
 
-    std::jthread write_thread
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect("127.0.0.1", 34578, 34588);
+    ig.connect("127.0.0.1", 34589, 34578);
+    EXPECT_EQ(host.send.set_backend(cigi::socket_backend::io_uring), cigi::socket_backend::io_uring);
+    ig.receive.reserve_batch(4, 2048);
+    if (ig.receive.set_backend(cigi::socket_backend::io_uring) != cigi::socket_backend::io_uring)
     {
-        [&session, &std1]()
+        GTEST_SKIP() << "no provided buffer rings";
+    }
+    // new buffers keep the ring, and so the descriptor an event loop waits on.
+    auto handle = ig.receive.native_handle();
+    ig.receive.reserve_batch(4, 2048);
+    ig.track_latency();
+    EXPECT_EQ(ig.receive.native_handle(), handle);
+
+    // more datagrams than a batch, to cycle the provided buffers.
+    using namespace std::chrono_literals;
+    std::vector<cigi::u16> received;
+    for (cigi::u16 frame = 0; frame < 20; ++frame)
+    {
+        cigi::entity_control ec;
+        ec.entity_id = frame;
+        host.write(ec);
+        host.flush();
+        for (int attempt = 0; attempt < 100 && ig.incoming.empty(decltype(ec.packet_id)::value); ++attempt)
+        {
+            ig.poll(10ms);
+        }
+        if (auto packet = ig.read<cigi::entity_control>())
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds{ 100 });
-            session.flush();
+            received.push_back(packet->entity_id);
         }
+    }
+
+    // a kernel without multishot recvmsg falls back on the first read.
+    EXPECT_EQ(received.size(), 20);
+    EXPECT_EQ(received.back(), 19);
+    EXPECT_EQ(host.send.packets_sent(), 20);
+};
+
+TEST(other, latency_per_packet_id)
+{
+    using namespace std::chrono_literals;
+    cigi::latency_histogram histogram;
+    for (auto latency : { 0ns, 3ns, 100ns, 1000ns, 1500ns, 20000ns })
+    {
+        histogram.record(latency);
+    }
+    EXPECT_EQ(histogram.count(), 6);
+    EXPECT_EQ(histogram.bucket(0), 1);
+    EXPECT_EQ(histogram.bucket(9), 1);
+    EXPECT_EQ(histogram.bucket(10), 1);
+    EXPECT_EQ(histogram.max(), 20us);
+    EXPECT_EQ(histogram.percentile(0.5), 127ns);
+    EXPECT_EQ(histogram.percentile(1.0), 20us);
+
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect("127.0.0.1", 34579, 34599);
+    ig.connect("127.0.0.1", 34598, 34579);
+    EXPECT_EQ(ig.latency<cigi::entity_control>(), nullptr);
+    if (!ig.track_latency())
+    {
+        GTEST_SKIP() << "no receive timestamps";
+    }
+
+    host.write(cigi::entity_control{});
+    host.write(cigi::entity_control{});
+    host.flush();
+    ASSERT_TRUE(ig.poll(1s));
+
+    const auto* latency = ig.latency<cigi::entity_control>();
+    ASSERT_NE(latency, nullptr);
+    EXPECT_EQ(latency->count(), 2);
+    EXPECT_GT(latency->max(), 0ns);
+    EXPECT_LT(latency->max(), 1s);
+    EXPECT_EQ(ig.latency<cigi::ig_control>()->count(), 0);
+};
+
+TEST(other, socket_options_report)
+{
+    using namespace std::chrono_literals;
+    using cigi::option_result;
+
+    cigi::socket_options options;
+    options.receive_buffer = 1 << 20;
+    options.dscp = 46;
+    options.non_blocking = true;
+
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect("127.0.0.1", 34614, 34615);
+    auto [send_result, receive_result] = ig.connect("127.0.0.1", 34615, 34614, "", options);
+
+    EXPECT_EQ(send_result.dscp, option_result::honored);
+    EXPECT_EQ(receive_result.non_blocking, option_result::honored);
+    EXPECT_EQ(receive_result.send_buffer, option_result::unset);
+    EXPECT_NE(receive_result.receive_buffer, option_result::unset);
+    EXPECT_EQ(receive_result.receive_buffer == option_result::honored, receive_result.receive_buffer_size >= (1 << 20));
+    EXPECT_GT(receive_result.send_buffer_size, 0);
+
+    cigi::socket_options bad;
+    bad.dscp = 64;
+    cigi::send_socket socket;
+    auto result = socket.connect("127.0.0.1", 34616, bad);
+    EXPECT_EQ(result.dscp, option_result::rejected);
+    EXPECT_FALSE(result.all_honored());
+
+    // non-blocking, so an empty socket returns at once.
+    EXPECT_TRUE(ig.receive.read_batch().empty());
+    host.write(cigi::ig_control{});
+    host.flush();
+    EXPECT_TRUE(ig.poll(1s));
+};
+
+TEST(other, shared_memory_session)
+{
+#ifndef __linux__
+    GTEST_SKIP() << "no shared memory transport";
+#else
+    using namespace std::chrono_literals;
+
+    std::string name = "/cigi-test-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    cigi::session_network host;
+    cigi::session_network ig;
+    ASSERT_TRUE(host.connect_shared(name, cigi::shared_memory_role::host, 4));
+    ASSERT_TRUE(ig.connect_shared(name, cigi::shared_memory_role::ig));
+    EXPECT_TRUE(ig.track_latency());
+
+    cigi::entity_control entity;
+    entity.entity_id = 7;
+    host.write(cigi::ig_control{});
+    host.write(entity);
+    host.flush();
+    ASSERT_TRUE(ig.poll(0us));
+    EXPECT_TRUE(ig.read<cigi::ig_control>().has_value());
+    ASSERT_EQ(ig.read<cigi::entity_control>().value().entity_id, 7);
+    EXPECT_EQ(ig.latency<cigi::entity_control>()->count(), 1);
+    EXPECT_FALSE(ig.poll(0us));
+
+    // wakes a receiver asleep in poll.
+    std::jthread responder{ [&]
+    {
+        std::this_thread::sleep_for(20ms);
+        ig.write(cigi::start_of_frame{});
+        ig.flush();
+    } };
+    ASSERT_TRUE(host.poll(1s));
+    EXPECT_TRUE(host.read<cigi::start_of_frame>().has_value());
+    responder.join();
+
+    // datagrams past the ring's 4 slots are dropped. the last datagram read
+    // holds its slot until the next read, so that's done first.
+    EXPECT_EQ(ig.drain(), 0);
+    for (int i = 0; i < 6; ++i)
+    {
+        host.write(cigi::ig_control{});
+        host.flush();
+    }
+    EXPECT_EQ(host.shared.overruns(), 2);
+    EXPECT_EQ(ig.drain(), 4);
+    EXPECT_EQ(ig.incoming.size(decltype(cigi::ig_control::packet_id)::value), 4);
+
+    // slots are kept short enough for datagram_index's 16-bit offsets.
+    cigi::shared_memory_channel wide;
+    ASSERT_TRUE(wide.open(name + "-wide", cigi::shared_memory_role::host, 2, 100'000));
+    EXPECT_EQ(wide.mtu(), 65535);
+#endif
+};
+
+TEST(other, loopback_transport)
+{
+    using namespace std::chrono_literals;
+
+    cigi::loopback_link link{ 4, 64 };
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect(link.host());
+    ig.connect(link.ig());
+    EXPECT_FALSE(ig.poll(0us));
+
+    // 24 + 48 bytes don't fit one 64 byte slot, so they go as two datagrams.
+    cigi::entity_control entity;
+    entity.entity_id = 3;
+    host.write(cigi::ig_control{});
+    host.write(entity);
+    host.flush();
+    EXPECT_EQ(link.ig_ring().occupancy(), 2);
+    EXPECT_EQ(ig.drain(), 2);
+    EXPECT_TRUE(ig.read<cigi::ig_control>().has_value());
+    EXPECT_EQ(ig.read<cigi::entity_control>().value().entity_id, 3);
+
+    // awaits resolve without any waiting.
+    std::optional<std::expected<cigi::start_of_frame, cigi::wait_error>> result;
+    [](cigi::session_network& host, auto& result) -> cigi::detached_task
+    {
+        result = co_await host.next<cigi::start_of_frame>();
+    }(host, result);
+    ig.write(cigi::start_of_frame{});
+    ig.flush();
+    EXPECT_TRUE(host.poll(0us));
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->has_value());
+
+    // past the ring's 4 slots, datagrams are dropped.
+    EXPECT_EQ(ig.drain(), 0);
+    for (int i = 0; i < 6; ++i)
+    {
+        host.write(cigi::ig_control{});
+        host.flush();
+    }
+    EXPECT_EQ(link.ig_ring().overruns(), 2);
+    EXPECT_EQ(ig.drain(), 4);
+};
+
+TEST(other, frame_builder_packs_datagrams)
+{
+    auto packet = [](cigi::u8 id, std::size_t size)
+    {
+        std::vector<std::byte> bytes(size);
+        bytes[0] = std::byte{ id };
+        bytes[1] = std::byte(size);
+        return bytes;
     };
+    std::vector<std::vector<std::byte>> storage{ packet(3, 30), packet(3, 80), packet(1, 20), packet(3, 70) };
+    std::vector<std::span<const std::byte>> packets(storage.begin(), storage.end());
+
+    // the IG Control goes first, the rest keep their order.
+    cigi::frame_builder builder;
+    auto ordered = builder.build(packets, 100);
+    ASSERT_EQ(ordered.size(), 4);
+    EXPECT_EQ(ordered[0].data(), storage[2].data());
+    EXPECT_EQ(ordered[1].data(), storage[0].data());
+    ASSERT_EQ(builder.datagrams().size(), 3);
+    EXPECT_DOUBLE_EQ(builder.fill(0), 0.5);
+    EXPECT_DOUBLE_EQ(builder.fill(1), 0.8);
+
+    // packed largest first, a datagram fewer.
+    builder.set_packing(cigi::packing::first_fit_decreasing);
+    ordered = builder.build(packets, 100);
+    ASSERT_EQ(builder.datagrams().size(), 2);
+    EXPECT_EQ(ordered[0].data(), storage[2].data());
+    EXPECT_EQ(ordered[1].data(), storage[1].data());
+    EXPECT_EQ(builder.datagrams()[1].count, 2);
+    EXPECT_DOUBLE_EQ(builder.mean_fill(), 1.0);
+
+    // and the session's sends split just the same.
+    cigi::loopback_link link{ 8, 64 };
+    cigi::session_network host;
+    host.connect(link.host());
+    host.write(cigi::entity_control{});
+    host.write(cigi::ig_control{});
+    host.flush();
+    auto batch = link.ig().read_batch();
+    ASSERT_EQ(batch.size(), host.frames.datagrams().size());
+    EXPECT_EQ(batch[0].bytes[0], std::byte{ decltype(cigi::ig_control::packet_id)::value });
+    EXPECT_EQ(batch[0].bytes.size(), host.frames.datagrams()[0].bytes);
+    EXPECT_DOUBLE_EQ(host.frames.fill(0), 24.0 / 64.0);
+};
+
+TEST(other, state_mirror_emits_changes)
+{
+    cigi::loopback_link link{ 64, 9216 };
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect(link.host());
+    ig.connect(link.ig());
+
+    cigi::state_mirror mirror{ 4 };
+    auto frame = [&](std::span<const cigi::entity_control> entities, const cigi::articulated_part_control& part)
+    {
+        for (const auto& entity : entities)
+        {
+            mirror.set(entity);
+        }
+        mirror.set(part);
+        auto counts = mirror.emit(host);
+        host.flush();
+        ig.drain();
+        return counts;
+    };
+
+    std::vector<cigi::entity_control> entities(8);
+    for (std::size_t i = 0; i < entities.size(); ++i)
+    {
+        entities[i].entity_id = cigi::u16(i);
+        entities[i].entity_state = cigi::active_t::active;
+    }
+    cigi::articulated_part_control part;
+    part.entity_id = 3;
+    part.articulated_part_id = 1;
+
+    // all new, the entities ahead of the part.
+    auto counts = frame(entities, part);
+    EXPECT_EQ(counts.changed, 9);
+    EXPECT_EQ(counts.held, 9);
+    EXPECT_EQ(ig.incoming.size(decltype(cigi::entity_control::packet_id)::value), 8);
+    EXPECT_EQ(ig.incoming.size(decltype(cigi::articulated_part_control::packet_id)::value), 1);
+    ig.incoming.clear();
+
+    // one change, and a quarter of the 9 refreshed.
+    entities[5].latitude = 10.0;
+    counts = frame(entities, part);
+    EXPECT_EQ(counts.changed, 1);
+    EXPECT_EQ(counts.refreshed, 2);
+    ASSERT_EQ(ig.incoming.size(decltype(cigi::entity_control::packet_id)::value), 3);
+    EXPECT_EQ(ig.read<cigi::entity_control>().value().entity_id, 5);
+    ig.incoming.clear();
+
+    // every packet is refreshed once over the interval.
+    std::size_t refreshed = counts.refreshed;
+    for (int i = 0; i < 3; ++i)
+    {
+        refreshed += frame(entities, part).refreshed;
+    }
+    EXPECT_EQ(refreshed, 9);
+
+    // a destroyed entity is sent once, then forgotten with its parts.
+    entities[3].entity_state = cigi::active_t::destroyed;
+    counts = frame(entities, part);
+    EXPECT_EQ(counts.changed, 1);
+    EXPECT_EQ(counts.held, 7);
+    EXPECT_EQ(mirror.entity_count(), 7);
+
+    mirror.set_refresh_interval(0);
+    mirror.refresh_all();
+    ig.incoming.clear();
+    entities.erase(entities.begin() + 3);
+    counts = frame(entities, part);
+    EXPECT_EQ(counts.changed, 8);
+    EXPECT_EQ(counts.refreshed, 0);
+    EXPECT_EQ(frame(entities, part).changed, 0);
+};
+
+TEST(other, state_mirror_shortens_small_changes)
+{
+    cigi::loopback_link link{ 64, 9216 };
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect(link.host());
+    ig.connect(link.ig());
+    cigi::state_mirror mirror{ 0 };
+
+    std::vector<cigi::articulated_part_control> parts(3);
+    for (std::size_t i = 0; i < parts.size(); ++i)
+    {
+        parts[i].entity_id = 9;
+        parts[i].articulated_part_id = cigi::u8(i);
+        parts[i].articulated_part_enable = cigi::enable_t::enabled;
+        parts[i].pitch_enable = cigi::enable_t::enabled;
+        parts[i].yaw_enable = cigi::enable_t::enabled;
+    }
+    cigi::component_control component;
+    component.component_id = 2;
+    component.instance_id = 9;
+    cigi::symbol_control symbol;
+    symbol.symbol_id = 4;
+
+    auto frame = [&]
+    {
+        for (const auto& part : parts)
+        {
+            mirror.set(part);
+        }
+        mirror.set(component);
+        mirror.set(symbol);
+        auto counts = mirror.emit(host);
+        host.flush();
+        ig.incoming.clear();
+        ig.drain();
+        return counts;
+    };
+    auto queued = [&]<typename T>() { return ig.incoming.size(decltype(T::packet_id)::value); };
+
+    // new state goes in full.
+    EXPECT_EQ(frame().shortened, 0);
+    EXPECT_EQ(queued.operator()<cigi::articulated_part_control>(), 3);
+
+    // two parts with a DOF each share one short packet, the third with two
+    // DOFs gets its own; the component's data fits, as do two attributes.
+    parts[0].pitch = 10.f;
+    parts[1].yaw = 20.f;
+    parts[2].pitch = 30.f;
+    parts[2].yaw = 40.f;
+    component.component_state = 1;
+    component.component_data[1] = 7;
+    symbol.position_u = 0.5f;
+    symbol.red = 255;
+    auto counts = frame();
+    EXPECT_EQ(counts.changed, 5);
+    EXPECT_EQ(counts.shortened, 5);
+    EXPECT_EQ(queued.operator()<cigi::articulated_part_control>(), 0);
+    ASSERT_EQ(queued.operator()<cigi::short_articulated_part_control>(), 2);
+    auto merged = ig.read<cigi::short_articulated_part_control>().value();
+    EXPECT_EQ(merged.articulated_part_id[0], 0);
+    EXPECT_EQ(merged.articulated_part_id[1], 1);
+    EXPECT_EQ(merged.dof_select_1, cigi::short_articulated_part_control::dof_select_t::pitch);
+    EXPECT_EQ(merged.dof[0].x_offset, 10.f);
+    EXPECT_EQ(merged.dof_select_2, cigi::short_articulated_part_control::dof_select_t::yaw);
+    EXPECT_EQ(merged.dof[1].x_offset, 20.f);
+    auto both = ig.read<cigi::short_articulated_part_control>().value();
+    EXPECT_EQ(both.articulated_part_id[0], 2);
+    EXPECT_EQ(both.articulated_part_id[1], 2);
+    ASSERT_EQ(queued.operator()<cigi::short_component_control>(), 1);
+    EXPECT_EQ(ig.read<cigi::short_component_control>().value().component_data[1], 7);
+    ASSERT_EQ(queued.operator()<cigi::short_symbol_control>(), 1);
+    auto short_symbol = ig.read<cigi::short_symbol_control>().value();
+    EXPECT_EQ(short_symbol.attribute_select[0], cigi::short_symbol_control::attribute_select_t::position_u);
+    EXPECT_EQ(short_symbol.attribute_select[1], cigi::short_symbol_control::attribute_select_t::color);
+
+    // a disabled DOF, a third data word, or three attributes need the full
+    // packet; so does everything after refresh_all.
+    parts[0].x_offset = 1.f;
+    component.component_data[2] = 1;
+    symbol.position_u = 0.f;
+    symbol.position_v = 1.f;
+    symbol.layer = 3;
+    counts = frame();
+    EXPECT_EQ(counts.shortened, 0);
+    EXPECT_EQ(queued.operator()<cigi::articulated_part_control>(), 1);
+    EXPECT_EQ(queued.operator()<cigi::component_control>(), 1);
+    EXPECT_EQ(queued.operator()<cigi::symbol_control>(), 1);
+
+    mirror.refresh_all();
+    counts = frame();
+    EXPECT_EQ(counts.changed, 5);
+    EXPECT_EQ(counts.shortened, 0);
+
+    // after refresh_all, e.g. for a restarted IG, a small change goes in
+    // full too.
+    mirror.refresh_all();
+    parts[0].pitch = 11.f;
+    counts = frame();
+    EXPECT_EQ(counts.changed, 5);
+    EXPECT_EQ(counts.shortened, 0);
+    EXPECT_EQ(queued.operator()<cigi::articulated_part_control>(), 3);
+    EXPECT_EQ(queued.operator()<cigi::short_articulated_part_control>(), 0);
+
+    mirror.set_short_packets(false);
+    parts[1].yaw = 0.f;
+    EXPECT_EQ(frame().shortened, 0);
+    EXPECT_EQ(queued.operator()<cigi::articulated_part_control>(), 1);
+};
+
+TEST(other, scheduler_defers_over_budget)
+{
+    cigi::loopback_link link{ 64, 9216 };
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect(link.host());
+    ig.connect(link.ig());
+
+    // an IG Control, own-ship, one entity, and one weather control.
+    host.scheduler.set_budget(24 + 48 + 48 + 56);
+    auto entity = [](cigi::u16 id)
+    {
+        cigi::entity_control packet;
+        packet.entity_id = id;
+        return packet;
+    };
+    auto weather = [](cigi::u16 region)
+    {
+        cigi::weather_control packet;
+        packet.region_id = region;
+        return packet;
+    };
+    auto frame = [&]
+    {
+        host.flush();
+        ig.incoming.clear();
+        ig.drain();
+    };
+    auto count = [&]<typename T>()
+    {
+        return ig.incoming.size(decltype(T::packet_id)::value);
+    };
+    constexpr auto low = cigi::packet_priority::low;
+
+    // immediate packets and normal ones go first; the weather waits.
+    host.write(cigi::ig_control{});
+    host.write(entity(0));
+    host.write(entity(1));
+    host.write(entity(2));
+    for (cigi::u16 region = 1; region <= 3; ++region)
+    {
+        host.write(weather(region));
+    }
+    frame();
+    EXPECT_EQ(count.operator()<cigi::ig_control>(), 1);
+    EXPECT_EQ(count.operator()<cigi::entity_control>(), 3);
+    EXPECT_EQ(count.operator()<cigi::weather_control>(), 0);
+    EXPECT_EQ(host.scheduler.deferred(low), 3);
+
+    // what's deferred goes in turn, ahead of anything new in its class.
+    host.write(cigi::ig_control{});
+    host.write(entity(0));
+    host.write(entity(1));
+    host.write(weather(4));
+    frame();
+    ASSERT_EQ(count.operator()<cigi::weather_control>(), 1);
+    EXPECT_EQ(ig.read<cigi::weather_control>().value().region_id, 1);
+    EXPECT_EQ(host.scheduler.deferred(low), 3);
+
+    // an override puts a packet ahead of its id's class.
+    host.write(cigi::ig_control{});
+    host.write(weather(5), cigi::packet_priority::immediate);
+    frame();
+    ASSERT_EQ(count.operator()<cigi::weather_control>(), 2);
+    EXPECT_EQ(ig.read<cigi::weather_control>().value().region_id, 5);
+    EXPECT_EQ(ig.read<cigi::weather_control>().value().region_id, 2);
+
+    host.write(cigi::ig_control{});
+    frame();
+    EXPECT_EQ(count.operator()<cigi::weather_control>(), 2);
+    EXPECT_EQ(host.scheduler.deferred(), 0);
+
+    const auto& stats = host.scheduler.stats(low);
+    EXPECT_EQ(stats.deferred, 4);
+    EXPECT_EQ(stats.dropped, 0);
+    EXPECT_EQ(stats.age.count(), 4);
+    EXPECT_EQ(stats.max_frames, 3);
+    EXPECT_EQ(host.scheduler.stats(cigi::packet_priority::normal).deferred, 0);
+
+    // past the limit, the oldest deferred packets are dropped.
+    host.scheduler.set_deferred_limit(1);
+    host.write(cigi::ig_control{});
+    host.write(entity(0));
+    host.write(entity(1));
+    host.write(entity(2));
+    host.write(weather(6));
+    host.write(weather(7));
+    frame();
+    EXPECT_EQ(host.scheduler.deferred(low), 1);
+    EXPECT_EQ(stats.dropped, 1);
+
+    // without a budget, what's deferred goes with the next frame.
+    host.scheduler.set_budget(0);
+    host.write(cigi::ig_control{});
+    frame();
+    ASSERT_EQ(count.operator()<cigi::weather_control>(), 1);
+    EXPECT_EQ(ig.read<cigi::weather_control>().value().region_id, 7);
+    EXPECT_EQ(host.scheduler.active(), false);
+};
+
+TEST(other, session_group_serializes_once)
+{
+    // small slots, so the frame spans datagrams.
+    std::array<cigi::loopback_link, 3> links{ cigi::loopback_link{ 64, 256 }, cigi::loopback_link{ 64, 256 }, cigi::loopback_link{ 64, 256 } };
+    std::array<cigi::session_network, 3> hosts;
+    std::array<cigi::session_network, 3> igs;
+    cigi::session_group group;
+    for (std::size_t i = 0; i < links.size(); ++i)
+    {
+        hosts[i].connect(links[i].host());
+        igs[i].connect(links[i].ig());
+        EXPECT_EQ(group.add(hosts[i]), i);
+    }
+    auto count = [](cigi::session_network& ig, cigi::u8 id)
+    {
+        return ig.incoming.size(id);
+    };
+    constexpr auto entity_id = decltype(cigi::entity_control::packet_id)::value;
+    constexpr auto view_id = decltype(cigi::view_control::packet_id)::value;
+
+    cigi::entity_control entity;
+    for (cigi::u16 i = 0; i < 10; ++i)
+    {
+        entity.entity_id = i;
+        group.write(entity);
+    }
+    group.write(cigi::ig_control{});
+    cigi::view_control view;
+    view.view_id = 7;
+    group.write(1, view);
+    group.flush();
+
+    // 24 + 10 * 48 bytes, at most 256 to a datagram.
+    auto frame = group.frame();
+    ASSERT_EQ(frame->datagrams.size(), 3);
+    EXPECT_EQ(frame->bytes.size(), 504);
+    EXPECT_EQ(cigi::u8(frame->datagrams[0][0]), decltype(cigi::ig_control::packet_id)::value);
+    for (std::size_t i = 0; i < igs.size(); ++i)
+    {
+        igs[i].drain();
+        EXPECT_EQ(count(igs[i], decltype(cigi::ig_control::packet_id)::value), 1);
+        EXPECT_EQ(count(igs[i], entity_id), 10);
+        EXPECT_EQ(count(igs[i], view_id), i == 1 ? 1 : 0);
+        EXPECT_EQ(links[i].ig_ring().high_water_mark(), 3);
+    }
+    EXPECT_EQ(igs[1].read<cigi::view_control>().value().view_id, 7);
+    EXPECT_TRUE(hosts[1].outgoing.empty());
+
+    // a frame still held isn't reused.
+    group.write(cigi::ig_control{});
+    group.flush();
+    EXPECT_NE(group.frame(), frame);
+    auto second = group.frame().get();
+    frame.reset();
+    group.write(cigi::ig_control{});
+    group.flush();
+    EXPECT_EQ(group.frame().get(), second);
+
+    // through one socket for the shared packets; only a channel's own
+    // packets go through its session.
+    cigi::session_network subscriber;
+    subscriber.connect("127.0.0.1", 34621, 34620);
+    ASSERT_TRUE(group.connect_multicast("127.0.0.1", 34620).all_honored());
+    for (auto& ig : igs)
+    {
+        ig.drain();
+        ig.incoming.clear();
+    }
+    group.write(cigi::ig_control{});
+    group.write(entity);
+    group.write(2, view);
+    group.flush();
+    using namespace std::chrono_literals;
+    ASSERT_TRUE(subscriber.poll(1s));
+    EXPECT_EQ(count(subscriber, entity_id), 1);
+    EXPECT_EQ(count(subscriber, view_id), 0);
+    // a channel's own datagram is led by the frame's IG Control.
+    for (std::size_t i = 0; i < igs.size(); ++i)
+    {
+        igs[i].drain();
+        EXPECT_EQ(count(igs[i], decltype(cigi::ig_control::packet_id)::value), i == 2 ? 1 : 0);
+        EXPECT_EQ(count(igs[i], entity_id), 0);
+        EXPECT_EQ(count(igs[i], view_id), i == 2 ? 1 : 0);
+    }
+    EXPECT_EQ(igs[2].index.begin()->packet_id, decltype(cigi::ig_control::packet_id)::value);
+};
+
+TEST(other, padded_packet_views)
+{
+    static_assert(cigi::member_offset<&cigi::entity_control::latitude> == cigi::entity_control::fields[cigi::field_index<cigi::entity_control>("latitude")].offset);
+    static_assert(cigi::member_offset<&cigi::entity_control::x_offset> == 24);
+    static_assert(cigi::member_offset<&cigi::entity_control::entity_id> == 2);
+
+    // an entity control from a newer minor version, 8 bytes longer.
+    cigi::entity_control ec;
+    ec.entity_id = 9;
+    ec.latitude = 45.0;
+    std::array<std::byte, 56> padded{};
+    cigi::entity_control::serialize_into(ec, padded);
+    padded[1] = std::byte{ 56 };
+
+    cigi::packet_view<cigi::entity_control> view{ padded };
+    ASSERT_TRUE(view.valid());
+    EXPECT_EQ(view.latitude(), 45.0);
+
+    cigi::loopback_link link;
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect(link.host());
+    ig.connect(link.ig());
+    std::array<std::span<const std::byte>, 1> packets{ std::span<const std::byte>{ padded } };
+    host.send_packets(packets);
+    ig.drain();
+    ASSERT_FALSE(ig.incoming.empty(decltype(cigi::entity_control::packet_id)::value));
+    auto peeked = ig.peek<cigi::entity_control>();
+    ASSERT_TRUE(peeked.has_value());
+    EXPECT_EQ(peeked->entity_id(), 9);
+};
+
+TEST(other, scheduler_progresses_and_coalesces)
+{
+    cigi::loopback_link link{ 64, 9216 };
+    cigi::session_network host;
+    cigi::session_network ig;
+    host.connect(link.host());
+    ig.connect(link.ig());
+
+    // an IG Control, own-ship, and not quite one more entity.
+    host.scheduler.set_budget(24 + 48 + 40);
+    auto entity = [](cigi::u16 id, cigi::f64 latitude = 0.0)
+    {
+        cigi::entity_control packet;
+        packet.entity_id = id;
+        packet.latitude = latitude;
+        return packet;
+    };
+    auto frame = [&](std::initializer_list<cigi::entity_control> entities)
+    {
+        host.write(cigi::ig_control{});
+        host.write(entity(0));
+        for (const auto& packet : entities)
+        {
+            host.write(packet);
+        }
+        host.flush();
+        ig.incoming.clear();
+        ig.drain();
+        std::vector<cigi::entity_control> received;
+        for (auto& packet : ig.read_all<cigi::entity_control>())
+        {
+            if (packet.entity_id != 0)
+            {
+                received.push_back(packet);
+            }
+        }
+        return received;
+    };
+    constexpr auto normal = cigi::packet_priority::normal;
+
+    // the first entity after the immediate packets goes over the budget,
+    // the second waits.
+    auto received = frame({ entity(1), entity(2) });
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received[0].entity_id, 1);
+    EXPECT_EQ(host.scheduler.deferred(normal), 1);
+
+    // the deferred entity is larger than what the budget leaves, but goes
+    // ahead of the new one rather than holding everything back.
+    received = frame({ entity(3) });
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received[0].entity_id, 2);
+    received = frame({});
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received[0].entity_id, 3);
+    EXPECT_EQ(host.scheduler.deferred(), 0);
+
+    // newer state for a waiting entity replaces it in line: the stale
+    // position is never sent.
+    received = frame({ entity(4), entity(5, 1.0), entity(6) });
+    EXPECT_EQ(host.scheduler.deferred(normal), 2);
+    received = frame({ entity(5, 2.0), entity(6, 3.0) });
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received[0].entity_id, 5);
+    EXPECT_EQ(cigi::f64(received[0].latitude), 2.0);
+    received = frame({ entity(6, 4.0) });
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received[0].entity_id, 6);
+    EXPECT_EQ(cigi::f64(received[0].latitude), 4.0);
 
-    auto future = session.read_async<cigi::symbol_text_definition>(std::launch::async);
-    std::this_thread::sleep_for(std::chrono::seconds{ 1 });
-    std::cout << future.get() << "\n\n";
-};
\ No newline at end of file
+    const auto& stats = host.scheduler.stats(normal);
+    EXPECT_EQ(stats.deferred, 4);
+    EXPECT_EQ(stats.replaced, 3);
+    EXPECT_EQ(stats.max_frames, 2);
+};